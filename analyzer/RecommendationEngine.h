@@ -54,10 +54,13 @@ public:
         double spaceScore;
         double suitabilityScore;
         string reasoning;
+        bool indistinguishable;  // timings overlap the fastest structure's at 95%
+        string tiedWith;         // that fastest structure
 
         StructureScore(string n = "Unknown")
             : name(n), totalScore(0.0), timeScore(0.0),
-            spaceScore(0.0), suitabilityScore(0.0), reasoning("") {}
+            spaceScore(0.0), suitabilityScore(0.0), reasoning(""),
+            indistinguishable(false), tiedWith("") {}
 
 
 
@@ -69,6 +72,9 @@ public:
             ss << "  Time Score: " << timeScore << "/100\n";
             ss << "  Space Score: " << spaceScore << "/100\n";
             ss << "  Suitability: " << suitabilityScore << "/100\n";
+            if (indistinguishable) {
+                ss << "  Time indistinguishable from " << tiedWith << "\n";
+            }
             ss << "Reasoning: " << reasoning << "\n";
             return ss.str();
         }
@@ -91,18 +97,30 @@ public:
 
             // calculate individual scores
             score.timeScore = calculateTimeScore(pair.second, opProfile);
+
+            // connectivity workloads also count the measured traversal speed
+            if (dataProfile.needsConnectivity && pair.second.traversalCount > 0) {
+                score.timeScore = (score.timeScore + calculateTraversalScore(pair.second)) / 2.0;
+            }
             score.spaceScore = calculateSpaceScore(pair.second, dataProfile);
             score.suitabilityScore = calculateSuitability(pair.first, dataProfile, opProfile);
 
+            scores.push_back(score);
+        }
+
+        // don't let run-to-run noise pick the winner
+        markIndistinguishable(scores, results);
+
+        for (auto& score : scores) {
+            const PerformanceMetrics& metrics = results.at(score.name);
+
             // calculate weighted total
             score.totalScore = (score.timeScore * weights.timeWeight) +
                                (score.spaceScore * weights.spaceWeight) +
                                (score.suitabilityScore * weights.suitabilityWeight);
 
             // generate reasoning
-            score.reasoning = generateReasoning(pair.first, score, pair.second, dataProfile, opProfile);
-
-            scores.push_back(score);
+            score.reasoning = generateReasoning(score.name, score, metrics, dataProfile, opProfile);
         }
 
         // sort by total score (descending)
@@ -114,6 +132,31 @@ public:
         return scores;
     }
 
+    // ================= STATISTICAL TIES =================
+    // structures whose total-time 95% interval overlaps the fastest one's
+    // cannot be told apart on speed; they get the fastest time score, so
+    // memory and suitability decide between them
+    void markIndistinguishable(vector<StructureScore>& scores,
+                               const map<string, PerformanceMetrics>& results) {
+        StructureScore* fastest = nullptr;
+        for (auto& score : scores) {
+            if (!fastest || score.timeScore > fastest->timeScore) {
+                fastest = &score;
+            }
+        }
+        if (!fastest) return;
+
+        const TrialStats& best = results.at(fastest->name).totalTimeStats;
+        for (auto& score : scores) {
+            if (&score == fastest) continue;
+            if (results.at(score.name).totalTimeStats.overlaps(best)) {
+                score.timeScore = fastest->timeScore;
+                score.indistinguishable = true;
+                score.tiedWith = fastest->name;
+            }
+        }
+    }
+
     // ================= TIME SCORE =================
     double calculateTimeScore(const PerformanceMetrics& metrics,
                               const OperationProfile& profile) {
@@ -121,28 +164,50 @@ public:
         double weightedTime = 0.0;
         double totalWeight = 0.0;
 
+        // weighted p99 over the operation types that recorded latencies
+        double weightedTail = 0.0;
+        double tailWeight = 0.0;
+
         if (metrics.insertCount > 0 && profile.insertPercent > 0) {
             double avgInsert = metrics.getAverageInsertTime();
             weightedTime += avgInsert * profile.insertPercent;
             totalWeight += profile.insertPercent;
+            if (metrics.insertLatency.getCount() > 0) {
+                weightedTail += metrics.getInsertLatency(99) * profile.insertPercent;
+                tailWeight += profile.insertPercent;
+            }
         }
 
         if (metrics.searchCount > 0 && profile.searchPercent > 0) {
             double avgSearch = metrics.getAverageSearchTime();
             weightedTime += avgSearch * profile.searchPercent;
             totalWeight += profile.searchPercent;
+            if (metrics.searchLatency.getCount() > 0) {
+                weightedTail += metrics.getSearchLatency(99) * profile.searchPercent;
+                tailWeight += profile.searchPercent;
+            }
         }
 
         if (metrics.deleteCount > 0 && profile.deletePercent > 0) {
             double avgDelete = metrics.getAverageDeleteTime();
             weightedTime += avgDelete * profile.deletePercent;
             totalWeight += profile.deletePercent;
+            if (metrics.deleteLatency.getCount() > 0) {
+                weightedTail += metrics.getDeleteLatency(99) * profile.deletePercent;
+                tailWeight += profile.deletePercent;
+            }
         }
 
         if (totalWeight == 0) return 50.0;
 
         double avgTime = weightedTime / totalWeight;
 
+        // rank on the tail as well as the mean, so rare slow operations
+        // (rehashes, rebalancing) count against a structure
+        if (tailWeight > 0) {
+            avgTime = (avgTime + weightedTail / tailWeight) / 2.0;
+        }
+
         // convert to score (lower time = higher score)
         // using exponential decay: score = 100 * e^(-k*time)
         double k = 0.5; // tuning parameter
@@ -151,6 +216,16 @@ public:
         return min(100.0, max(0.0, score));
     }
 
+    // ================= TRAVERSAL SCORE =================
+    double calculateTraversalScore(const PerformanceMetrics& metrics) {
+        double throughput = metrics.getTraversalThroughput();
+        if (throughput <= 0) return 0.0;
+
+        // log scale: 1M vertices/s scores 75, 100M vertices/s scores 100
+        double score = 12.5 * log10(throughput);
+        return min(100.0, max(0.0, score));
+    }
+
     // ================= SPACE SCORE =================
     double calculateSpaceScore(const PerformanceMetrics& metrics,
                                const DataAnalyzer::DataProfile& profile) {
@@ -185,7 +260,8 @@ public:
                                 const OperationProfile& opProfile) {
         double score = 50.0; // base score
 
-        if (structureName == "HashMap") {
+        if (structureName == "HashMap" || structureName == "FlatHashMap" ||
+            structureName == "IncrementalHashMap") {
             // HashMap excels at fast lookups
             if (opProfile.searchPercent > 60) score += 25;
             else if (opProfile.searchPercent > 40) score += 15;
@@ -218,7 +294,18 @@ public:
             // balanced performance
             if (opProfile.searchPercent + opProfile.insertPercent > 60) score += 5;
         }
-        else if (structureName == "Trie") {
+        else if (structureName == "FrozenBST") {
+            // static sorted index: only built for read-only workloads
+            if (profile.isSorted) score += 20;
+            if (profile.needsRangeQueries) score += 30;
+
+            // lookups touch one contiguous array
+            if (opProfile.searchPercent > 60) score += 20;
+
+            // cannot absorb updates without a rebuild
+            if (opProfile.insertPercent > 0 || opProfile.deletePercent > 0) score -= 40;
+        }
+        else if (structureName == "Trie" || structureName == "RadixTrie") {
             // Trie is specialized for strings
             if (profile.dataType == "string") score += 30;
             else score -= 30; // heavily penalize for non-strings
@@ -226,9 +313,14 @@ public:
             // excellent for prefix searches
             if (profile.needsPrefixSearch) score += 40;
 
-            // good for shorter strings
-            if (profile.averageStringLength < 15) score += 10;
-            else if (profile.averageStringLength > 30) score -= 10;
+            // good for shorter strings; path compression absorbs long
+            // single-child chains, so long keys favour the radix variant
+            if (structureName == "Trie") {
+                if (profile.averageStringLength < 15) score += 10;
+                else if (profile.averageStringLength > 30) score -= 10;
+            } else if (profile.averageStringLength > 15) {
+                score += 10;
+            }
 
             // memory intensive for large datasets
             if (profile.dataSize > 10000) score -= 10;
@@ -249,6 +341,32 @@ public:
             // memory efficient
             if (profile.memoryConstrained) score += 15;
         }
+        else if (structureName == "RadixHeap") {
+            // monotone integer priority queue (Dijkstra-like timestamps)
+            if (profile.needsPriorityQueue) score += 50;
+
+            // only integer keys can be bucketed by bits
+            if (profile.dataType == "integer") score += 10;
+            else score -= 40;
+
+            // extract-min heavy workloads are its strength
+            if (opProfile.deletePercent > 30) score += 15;
+
+            // cannot search arbitrary elements at all
+            if (opProfile.searchPercent > 30) score -= 35;
+            else if (opProfile.searchPercent > 0) score -= 15;
+        }
+        else if (structureName == "Queue") {
+            // FIFO buffer: only the ends are accessible
+            // insert/delete dominated workloads are what it is built for
+            if (opProfile.insertPercent + opProfile.deletePercent >= 70) score += 25;
+
+            // no ordering by value and no lookup of arbitrary elements
+            if (profile.needsPriorityQueue) score -= 20;
+            if (profile.needsRangeQueries || profile.needsPrefixSearch) score -= 20;
+            if (opProfile.searchPercent > 30) score -= 40;
+            else if (opProfile.searchPercent > 0) score -= 20;
+        }
         else if (structureName == "Graph") {
             // Graph is for relationship/network data
             if (profile.hasRelationships) score += 40;
@@ -304,7 +422,8 @@ public:
         }
 
         // suitability analysis
-        if (structureName == "HashMap") {
+        if (structureName == "HashMap" || structureName == "FlatHashMap" ||
+            structureName == "IncrementalHashMap") {
             if (opProfile.searchPercent > 60) {
                 ss << "Ideal for search-heavy workloads. ";
             }
@@ -320,13 +439,22 @@ public:
                 ss << "Works well with sorted data. ";
             }
         }
-        else if (structureName == "Trie") {
+        else if (structureName == "FrozenBST") {
+            ss << "Read-only sorted index with cache-friendly lookups. ";
+            if (profile.needsRangeQueries) {
+                ss << "Supports range queries. ";
+            }
+        }
+        else if (structureName == "Trie" || structureName == "RadixTrie") {
             if (profile.dataType == "string") {
                 ss << "Optimized for string operations. ";
             }
             if (profile.needsPrefixSearch) {
                 ss << "Excellent for prefix searches. ";
             }
+            if (structureName == "RadixTrie" && profile.averageStringLength > 15) {
+                ss << "Path compression shortens long keys. ";
+            }
         }
         else if (structureName == "Heap") {
             if (profile.needsPriorityQueue) {
@@ -336,18 +464,41 @@ public:
                 ss << "Not ideal for frequent searches. ";
             }
         }
+        else if (structureName == "RadixHeap") {
+            if (profile.needsPriorityQueue) {
+                ss << "Fastest option for monotone integer priority queues. ";
+            }
+            if (opProfile.searchPercent > 0) {
+                ss << "Does not support searching. ";
+            }
+        }
+        else if (structureName == "Queue") {
+            ss << "Constant-time FIFO enqueue/dequeue on a ring buffer. ";
+            if (opProfile.searchPercent > 0) {
+                ss << "Does not support searching. ";
+            }
+        }
         else if (structureName == "Graph") {
             if (profile.hasRelationships) {
                 ss << "Ideal for relationship/network data. ";
             }
             if (profile.needsConnectivity) {
                 ss << "Perfect for connectivity and path finding. ";
+                if (metrics.traversalCount > 0) {
+                    ss << "Traversals measured at " << fixed << setprecision(1)
+                       << metrics.getTraversalThroughput() / 1e6 << "M vertices/s. ";
+                }
             }
             if (profile.memoryConstrained) {
                 ss << "Consider memory usage for large graphs. ";
             }
         }
 
+        if (score.indistinguishable) {
+            ss << "Timings are within run-to-run noise of " << score.tiedWith
+               << ", so memory and suitability decide between them. ";
+        }
+
         return ss.str();
     }
 
@@ -404,32 +555,76 @@ public:
             ss << "• Best when order doesn't matter\n";
             ss << "• Use when: Fast lookups are critical\n";
         }
+        else if (winner.name == "FlatHashMap") {
+            ss << "Open-addressing HashMap provides:\n";
+            ss << "• O(1) average-case search, insert, and delete\n";
+            ss << "• Entries stored inline, 16 slots checked per probe\n";
+            ss << "• Fewer cache misses than chaining, no per-entry allocation\n";
+            ss << "• Use when: Lookup throughput is critical\n";
+        }
+        else if (winner.name == "IncrementalHashMap") {
+            ss << "Incrementally rehashed HashMap provides:\n";
+            ss << "• O(1) average-case search, insert, and delete\n";
+            ss << "• Resizes spread over later operations, no O(n) pause\n";
+            ss << "• Briefly keeps the old bucket array while migrating\n";
+            ss << "• Use when: Tail latency matters more than throughput\n";
+        }
         else if (winner.name == "BST") {
             ss << "Binary Search Tree provides:\n";
-            ss << "• O(log n) operations (when balanced)\n";
+            ss << "• O(log n) operations (AVL-balanced)\n";
             ss << "• Maintains sorted order\n";
             ss << "• Supports range queries efficiently\n";
             ss << "• Use when: You need sorted data or ranges\n";
         }
+        else if (winner.name == "FrozenBST") {
+            ss << "Frozen BST (Eytzinger array) provides:\n";
+            ss << "• O(log n) search in one contiguous array with prefetching\n";
+            ss << "• Sorted range queries and O(log n) min/max\n";
+            ss << "• No per-node pointers, so less memory than a BST\n";
+            ss << "• Use when: Data is built once and only queried\n";
+        }
         else if (winner.name == "Trie") {
             ss << "Trie provides:\n";
             ss << "• O(m) operations where m = string length\n";
+            ss << "• Adaptive 4/16/48/256-way nodes keep sparse levels compact\n";
             ss << "• Excellent for prefix matching\n";
-            ss << "• Perfect for autocomplete features\n";
+            ss << "• Perfect for autocomplete: top-k completions ranked by frequency\n";
             ss << "• Use when: Working with strings and prefixes\n";
         }
+        else if (winner.name == "RadixTrie") {
+            ss << "Radix Trie provides:\n";
+            ss << "• O(m) operations where m = string length\n";
+            ss << "• Single-child chains collapsed into one node with a string fragment\n";
+            ss << "• Fewer nodes and shorter search paths for long keys\n";
+            ss << "• Use when: Long keys with shared prefixes (URLs, paths, IDs)\n";
+        }
         else if (winner.name == "Heap") {
             ss << "Heap provides:\n";
             ss << "• O(log n) insert and extract-min/max\n";
             ss << "• O(1) peek at min/max element\n";
+            ss << "• O(1) contains, O(log n) remove/update via position index\n";
             ss << "• Perfect for priority queues\n";
             ss << "• Use when: Need min/max element frequently\n";
         }
+        else if (winner.name == "RadixHeap") {
+            ss << "Radix Heap provides:\n";
+            ss << "• O(1) insert, O(log C) amortized extract-min\n";
+            ss << "• No key comparisons within a bucket\n";
+            ss << "• Requires keys never below the last extracted one\n";
+            ss << "• Use when: Monotone integer priorities (Dijkstra, event timestamps)\n";
+        }
+        else if (winner.name == "Queue") {
+            ss << "Queue provides:\n";
+            ss << "• O(1) amortized enqueue and dequeue\n";
+            ss << "• Contiguous ring buffer, no allocation per element\n";
+            ss << "• Strict first-in, first-out order\n";
+            ss << "• Use when: Tasks or events are processed in arrival order\n";
+        }
         else if (winner.name == "Graph") {
             ss << "Graph provides:\n";
             ss << "• O(1) to O(V+E) operations depending on query\n";
             ss << "• Models relationships between entities\n";
-            ss << "• Supports BFS, DFS, shortest path algorithms\n";
+            ss << "• BFS, DFS, Dijkstra and connected components over a CSR snapshot\n";
             ss << "• Use when: Data has connections/relationships\n";
         }
 
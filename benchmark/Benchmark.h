@@ -2,11 +2,18 @@
 #define BENCHMARK_H
 
 #include "PerformanceMetrics.h"
+#include "OperationStream.h"
+#include "MemoryTracker.h"
+#include "HardwareCounters.h"
 #include "Heap.h"
+#include "IndexedHeap.h"
+#include "RadixHeap.h"
 #include "BST.h"
 #include "HashMap.h"
 #include "Trie.h"
 #include "Graph.h"
+#include "Queue.h"
+#include "ConcurrentQueue.h"
 #include <vector>
 #include <map>
 #include <chrono>
@@ -17,10 +24,43 @@
 #include <limits>
 #include <string>
 #include <functional>
+#include <thread>
 
 using namespace std;
 using namespace std::chrono;
 
+// traversal workload shared by both Benchmark classes: freeze the graph to
+// CSR, then BFS, DFS and Dijkstra from source plus connected components;
+// returns the number of vertices visited
+template<typename T>
+long long runGraphTraversals(const Graph<T>& graph, const T& source) {
+    CSRGraph<T> csr = graph.toCSR();
+    uint32_t s = csr.id(source);
+    if (s == CSRGraph<T>::NoVertex)
+        return 0;
+
+    long long visited = csr.bfs(s).size();
+    visited += csr.dfs(s).size();
+    for (double d : csr.shortestPaths(s))
+        visited += d != numeric_limits<double>::infinity();
+
+    vector<uint32_t> component;
+    csr.connectedComponents(component);
+    visited += component.size();
+    return visited;
+}
+
+// replace a test's memory estimate with the heap use measured inside its
+// timed regions: bytes still live at the end, the peak and the number of
+// allocations; estimates stay when the operator new hook is not linked in
+inline void recordHeapUsage(PerformanceMetrics& m) {
+    if (MemoryTracker::getAllocationCount() == 0)
+        return;
+    m.memoryUsed = MemoryTracker::getLiveBytes();
+    m.peakMemory = MemoryTracker::getPeakBytes();
+    m.allocationCount = MemoryTracker::getAllocationCount();
+}
+
 // template class for benchmarking any data type
 template<typename T>
 class Benchmark {
@@ -31,10 +71,11 @@ public:
         int insertPercent;
         int deletePercent;
         int totalOperations;
+        unsigned seed;  // fixes the operation stream, so runs are repeatable
 
-        OperationProfile(int search, int insert, int del, int total)
+        OperationProfile(int search, int insert, int del, int total, unsigned seed = 42)
             : searchPercent(search), insertPercent(insert),
-            deletePercent(del), totalOperations(total)
+            deletePercent(del), totalOperations(total), seed(seed)
         {
             if (search + insert + del != 100)
                 throw invalid_argument("Percentages must sum to 100");
@@ -57,6 +98,7 @@ public:
             result += "  Delete: " + to_string(deletePercent) + "% (" +
                       to_string(getDeleteCount()) + " ops)\n";
             result += "  Total: " + to_string(totalOperations) + " operations\n";
+            result += "  Seed: " + to_string(seed) + "\n";
             return result;
         }
     };
@@ -65,7 +107,7 @@ public:
     using ProgressCallback = function<void(int percentage, const string& message)>;
 
     // constructor
-    Benchmark() : progressCallback(nullptr) {
+    Benchmark() : progressCallback(nullptr), warmupRuns(1), repetitions(5) {
         random_device rd;
         rng.seed(rd());
     }
@@ -75,14 +117,62 @@ public:
         progressCallback = callback;
     }
 
-    // measure time of any operation
+    // runAllTests runs every structure warmup times unmeasured, then
+    // measured times, and reports medians with their spread
+    void setRepetitions(int warmup, int measured) {
+        if (warmup < 0 || measured < 1)
+            throw invalid_argument("Need at least one measured repetition");
+        warmupRuns = warmup;
+        repetitions = measured;
+    }
+
+    // warm caches, allocator and branch predictors with unmeasured runs,
+    // then aggregate the measured ones
+    template<typename Test>
+    PerformanceMetrics runTrials(Test test) {
+        for (int i = 0; i < warmupRuns; i++)
+            test();
+        vector<PerformanceMetrics> trials;
+        for (int i = 0; i < repetitions; i++) {
+            MemoryTracker::reset();
+            PerformanceMetrics m = test();
+            recordHeapUsage(m);
+            trials.push_back(m);
+        }
+        return PerformanceMetrics::aggregate(trials);
+    }
+
+    // perf_event counters around measured phases; on by default, falls back
+    // to timing only where the kernel refuses them
+    void setHardwareCounters(bool enabled) {
+        perfCounters.setEnabled(enabled);
+    }
+
+    // measure time of any operation; its allocations count towards the
+    // structure's heap use and, given counters, its hardware events are
+    // added there (the counter reads stay outside the timed region)
+    template<typename Func>
+    double measureTime(Func function, HardwareCounters* counters = nullptr) {
+        MemoryTracker::Scope track;
+        double ms = 0.0;
+        auto timed = [&]() {
+            auto start = high_resolution_clock::now();
+            function();
+            auto end = high_resolution_clock::now();
+            duration<double, milli> elapsed = end - start;
+            ms = elapsed.count();
+        };
+        if (counters)
+            countEvents(*counters, timed);
+        else
+            timed();
+        return ms;
+    }
+
+    // add the hardware events caused by f
     template<typename Func>
-    double measureTime(Func function) {
-        auto start = high_resolution_clock::now();
-        function();
-        auto end = high_resolution_clock::now();
-        duration<double, milli> elapsed = end - start;
-        return elapsed.count();
+    void countEvents(HardwareCounters& into, Func f) {
+        into += perfCounters.measure(f);
     }
 
     // generate random keys from existing data
@@ -120,6 +210,22 @@ public:
         return newValues;
     }
 
+    // restart the rng from the profile's seed; every test that draws keys
+    // calls this first, so its keys do not depend on which tests ran before
+    void reseed(const OperationProfile& profile) {
+        rng.seed(profile.seed);
+    }
+
+    // interleaved operations for profile; the rng is reseeded from the
+    // profile so every structure replays the same stream
+    vector<Operation<T>> generateOperationStream(const vector<T>& data,
+                                                 const OperationProfile& profile) {
+        reseed(profile);
+        vector<T> newVals = generateNewValues(profile.getInsertCount());
+        return buildOperationStream(profile.getSearchCount(), profile.getInsertCount(),
+                                    profile.getDeleteCount(), data, newVals, rng);
+    }
+
     void updateProgress(int pct, const string& msg) {
         if (progressCallback) {
             progressCallback(pct, msg);
@@ -130,7 +236,7 @@ public:
     PerformanceMetrics testBST(const vector<T>& initialData, const OperationProfile& profile) {
         PerformanceMetrics m("BST");
         m.dataSize = initialData.size();
-        BST<T> bst;
+        BST<T, AVLBalancing> bst;
 
         updateProgress(0, "[BST] Starting test");
 
@@ -139,54 +245,169 @@ public:
         m.insertTime = measureTime([&]() {
             for (const T& val : initialData)
                 bst.insert(val);
+        }, &m.insertCounters);
+        m.insertCount = initialData.size();
+
+        // phase 2: interleaved searches, inserts and deletes
+        updateProgress(30, "[BST] Running mixed operations");
+        vector<Operation<T>> ops = generateOperationStream(initialData, profile);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const T& key) { return bst.searchValue(key); },
+                [&](const T& key) { bst.insert(key); },
+                [&](const T& key) { bst.remove(key); }));
         });
+
+        // phase 3: memory (node slabs)
+        m.memoryUsed = bst.getReservedBytes();
+
+        // phase 4: total time
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[BST] Complete");
+        return m;
+    }
+
+    // test frozen BST: build the tree, freeze it into a static index and
+    // measure read-only lookups against it (compare with the BST entry)
+    PerformanceMetrics testFrozenBST(const vector<T>& initialData, const OperationProfile& profile) {
+        PerformanceMetrics m("FrozenBST");
+        m.dataSize = initialData.size();
+        StaticSearchTree<T> index;
+
+        updateProgress(0, "[FrozenBST] Starting test");
+        reseed(profile);
+
+        // phase 1: build and freeze
+        updateProgress(5, "[FrozenBST] Building and freezing tree");
+        m.insertTime = measureTime([&]() {
+            BST<T, AVLBalancing> bst;
+            for (const T& val : initialData)
+                bst.insert(val);
+            index = bst.freeze();
+        }, &m.insertCounters);
         m.insertCount = initialData.size();
 
         // phase 2: search operations
         int searchCnt = profile.getSearchCount();
         if (searchCnt > 0) {
-            updateProgress(30, "[BST] Performing searches");
+            updateProgress(30, "[FrozenBST] Performing searches");
             vector<T> searchKeys = generateRandomKeys(initialData, searchCnt);
             m.searchTime = measureTime([&]() {
+                size_t hits = 0;
                 for (const T& key : searchKeys)
-                    bst.searchValue(key);
-            });
+                    hits += index.searchValue(key);
+                consume(hits);
+            }, &m.searchCounters);
             m.searchCount = searchCnt;
         }
 
-        // phase 3: additional inserts
+        // phase 3: memory
+        m.memoryUsed = index.getMemoryUsage();
+
+        // phase 4: total time
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[FrozenBST] Complete");
+        return m;
+    }
+
+    // test BST order statistics: percentile-style rank(x) and select(k)
+    // queries, half of the search budget each
+    PerformanceMetrics testOrderStatistics(const vector<T>& initialData, const OperationProfile& profile) {
+        PerformanceMetrics m("BST rank/select");
+        m.dataSize = initialData.size();
+        BST<T, AVLBalancing> bst;
+
+        updateProgress(0, "[BST rank/select] Starting test");
+        reseed(profile);
+
+        // phase 1: insert initial data
+        updateProgress(5, "[BST rank/select] Inserting initial data");
+        m.insertTime = measureTime([&]() {
+            for (const T& val : initialData)
+                bst.insert(val);
+        }, &m.insertCounters);
+        m.insertCount = initialData.size();
+
+        // phase 2: rank and select queries
+        int queryCnt = profile.getSearchCount();
+        if (queryCnt > 0 && bst.countNodes() > 0) {
+            updateProgress(30, "[BST rank/select] Performing queries");
+            vector<T> rankKeys = generateRandomKeys(initialData, queryCnt / 2);
+            vector<int> ranks;
+            uniform_int_distribution<int> dist(0, bst.countNodes() - 1);
+            for (int i = 0; i < queryCnt - queryCnt / 2; i++)
+                ranks.push_back(dist(rng));
+
+            m.searchTime = measureTime([&]() {
+                size_t total = 0;
+                for (const T& key : rankKeys)
+                    total += bst.rank(key);
+                for (int k : ranks)
+                    total += bst.select(k) == T();
+                consume(total);
+            }, &m.searchCounters);
+            m.searchCount = queryCnt;
+        }
+
+        m.memoryUsed = bst.getReservedBytes();
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[BST rank/select] Complete");
+        return m;
+    }
+
+    // test d-ary Heap: priority-queue workload (insert, then extractTop),
+    // used to sweep the arity
+    template<int Arity>
+    PerformanceMetrics testHeapArity(const vector<T>& initialData, const OperationProfile& profile) {
+        string name = "Heap d=" + to_string(Arity);
+        string tag = "[" + name + "] ";
+        PerformanceMetrics m(name);
+        m.dataSize = initialData.size();
+        Heap<T, Arity> heap(true);
+
+        updateProgress(0, tag + "Starting test");
+        reseed(profile);
+
+        // phase 1: insert initial data
+        updateProgress(5, tag + "Inserting initial data");
+        m.insertTime = measureTime([&]() {
+            for (const T& val : initialData)
+                heap.insert(val);
+        }, &m.insertCounters);
+        m.insertCount = initialData.size();
+
+        // phase 2: additional inserts
         int addInserts = profile.getInsertCount();
         if (addInserts > 0) {
-            updateProgress(60, "[BST] Additional inserts");
+            updateProgress(40, tag + "Additional inserts");
             vector<T> newVals = generateNewValues(addInserts);
-            double addTime = measureTime([&]() {
+            m.insertTime += measureTime([&]() {
                 for (const T& val : newVals)
-                    bst.insert(val);
-            });
-            m.insertTime += addTime;
+                    heap.insert(val);
+            }, &m.insertCounters);
             m.insertCount += addInserts;
         }
 
-        // phase 4: delete operations
-        int delCnt = profile.getDeleteCount();
-        if (delCnt > 0) {
-            updateProgress(80, "[BST] Deleting elements");
-            vector<T> delKeys = generateRandomKeys(initialData, delCnt);
+        // phase 3: extractTop, one per operation in the profile
+        int extractCnt = min(profile.totalOperations, heap.size());
+        if (extractCnt > 0) {
+            updateProgress(70, tag + "Extracting top elements");
             m.deleteTime = measureTime([&]() {
-                for (const T& key : delKeys)
-                    bst.remove(key);
-            });
-            m.deleteCount = delCnt;
+                size_t total = 0;
+                for (int i = 0; i < extractCnt; i++)
+                    total += heap.extractTop() == T();
+                consume(total);
+            }, &m.deleteCounters);
+            m.deleteCount = extractCnt;
         }
 
-        // phase 5: calculate memory
-        int nodes = bst.countNodes();
-        m.memoryUsed = nodes * (sizeof(T) + 2 * sizeof(void*) + sizeof(int));
-
-        // phase 6: total time
+        m.memoryUsed = heap.getMemoryUsage();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
 
-        updateProgress(100, "[BST] Complete");
+        updateProgress(100, tag + "Complete");
         return m;
     }
 
@@ -195,7 +416,7 @@ public:
                                 const OperationProfile& profile) {
         PerformanceMetrics m("Heap");
         m.dataSize = initialData.size();
-        Heap<T> heap(false);
+        IndexedHeap<T> heap(false);  // position map: O(1) search, O(log n) removeValue
 
         updateProgress(0, "[Heap] Starting test");
 
@@ -204,121 +425,184 @@ public:
         m.insertTime = measureTime([&]() {
             for (const T& val : initialData)
                 heap.insert(val);
-        });
+        }, &m.insertCounters);
         m.insertCount = initialData.size();
 
-        // phase 2: search
-        int searchCnt = profile.getSearchCount();
-        if (searchCnt > 0) {
-            updateProgress(30, "[Heap] Performing searches");
-            vector<T> searchKeys = generateRandomKeys(initialData, searchCnt);
-            m.searchTime = measureTime([&]() {
-                for (const T& key : searchKeys)
-                    heap.search(key);
-            });
-            m.searchCount = searchCnt;
-        }
+        // phase 2: interleaved searches, inserts and deletes
+        updateProgress(30, "[Heap] Running mixed operations");
+        vector<Operation<T>> ops = generateOperationStream(initialData, profile);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const T& key) { return heap.search(key); },
+                [&](const T& key) { heap.insert(key); },
+                [&](const T& key) { heap.removeValue(key); }));
+        });
+
+        // phase 3: memory
+        m.memoryUsed = heap.getMemoryUsage();
 
-        // phase 3: additional inserts
+        // phase 4: total
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[Heap] Complete");
+        return m;
+    }
+
+    // test RadixHeap (integer keys only): monotone priority-queue workload
+    // radix heaps cannot search, so the search phase is skipped and deletes
+    // are extractTop calls
+    PerformanceMetrics testRadixHeap(const vector<T>& initialData,
+                                     const OperationProfile& profile) {
+        PerformanceMetrics m("RadixHeap");
+        m.dataSize = initialData.size();
+        RadixHeap<T> heap;
+
+        updateProgress(0, "[RadixHeap] Starting test");
+        reseed(profile);
+
+        // phase 1: insert
+        updateProgress(5, "[RadixHeap] Inserting initial data");
+        m.insertTime = measureTime([&]() {
+            for (const T& val : initialData)
+                heap.insert(val);
+        }, &m.insertCounters);
+        m.insertCount = initialData.size();
+
+        // phase 2: additional inserts (before any extraction, so always monotone)
         int addInserts = profile.getInsertCount();
         if (addInserts > 0) {
-            updateProgress(60, "[Heap] Additional inserts");
+            updateProgress(40, "[RadixHeap] Additional inserts");
             vector<T> newVals = generateNewValues(addInserts);
             double addTime = measureTime([&]() {
                 for (const T& val : newVals)
                     heap.insert(val);
-            });
+            }, &m.insertCounters);
             m.insertTime += addTime;
             m.insertCount += addInserts;
         }
 
-        // phase 4: delete
-        int delCnt = profile.getDeleteCount();
+        // phase 3: delete = extract minimum
+        int delCnt = min(profile.getDeleteCount(), heap.size());
         if (delCnt > 0) {
-            updateProgress(80, "[Heap] Deleting elements");
-            vector<T> delKeys = generateRandomKeys(initialData, delCnt);
+            updateProgress(80, "[RadixHeap] Extracting elements");
             m.deleteTime = measureTime([&]() {
-                for (const T& key : delKeys)
-                    heap.removeValue(key);
-            });
+                size_t total = 0;
+                for (int i = 0; i < delCnt; i++)
+                    total += heap.extractTop() == T();
+                consume(total);
+            }, &m.deleteCounters);
             m.deleteCount = delCnt;
         }
 
-        // phase 5: memory
-        m.memoryUsed = heap.size() * sizeof(T);
+        // phase 4: memory
+        m.memoryUsed = heap.getMemoryUsage();
 
-        // phase 6: total
+        // phase 5: total
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
 
-        updateProgress(100, "[Heap] Complete");
+        updateProgress(100, "[RadixHeap] Complete");
         return m;
     }
 
-    // test HashMap
-    template<typename V = T>
-    PerformanceMetrics testHashMap(const vector<T>& initialData,
-                                   const OperationProfile& profile) {
-        PerformanceMetrics m("HashMap");
+    // test Queue: FIFO workload
+    // a queue cannot search, so the search phase is skipped; inserts are
+    // enqueues and deletes dequeue from the front
+    PerformanceMetrics testQueue(const vector<T>& initialData,
+                                 const OperationProfile& profile) {
+        PerformanceMetrics m("Queue");
         m.dataSize = initialData.size();
-        HashMap<T, V> map;
+        Queue<T> queue;
 
-        updateProgress(0, "[HashMap] Starting test");
+        updateProgress(0, "[Queue] Starting test");
+        reseed(profile);
 
-        // phase 1: insert
-        updateProgress(5, "[HashMap] Inserting initial data");
+        // phase 1: enqueue
+        updateProgress(5, "[Queue] Enqueuing initial data");
         m.insertTime = measureTime([&]() {
             for (const T& val : initialData)
-                map.insert(val, static_cast<V>(val));
-        });
+                queue.enqueue(val);
+        }, &m.insertCounters);
         m.insertCount = initialData.size();
 
-        // phase 2: search
-        int searchCnt = profile.getSearchCount();
-        if (searchCnt > 0) {
-            updateProgress(30, "[HashMap] Performing searches");
-            vector<T> searchKeys = generateRandomKeys(initialData, searchCnt);
-            m.searchTime = measureTime([&]() {
-                for (const T& key : searchKeys)
-                    map.search(key);
-            });
-            m.searchCount = searchCnt;
-        }
-
-        // phase 3: additional inserts
+        // phase 2: additional enqueues
         int addInserts = profile.getInsertCount();
         if (addInserts > 0) {
-            updateProgress(60, "[HashMap] Additional inserts");
+            updateProgress(40, "[Queue] Additional enqueues");
             vector<T> newVals = generateNewValues(addInserts);
             double addTime = measureTime([&]() {
                 for (const T& val : newVals)
-                    map.insert(val, static_cast<V>(val));
-            });
+                    queue.enqueue(val);
+            }, &m.insertCounters);
             m.insertTime += addTime;
             m.insertCount += addInserts;
         }
 
-        // phase 4: delete
-        int delCnt = profile.getDeleteCount();
+        // phase 3: dequeue
+        int delCnt = min(profile.getDeleteCount(), queue.size());
         if (delCnt > 0) {
-            updateProgress(80, "[HashMap] Deleting elements");
-            vector<T> delKeys = generateRandomKeys(initialData, delCnt);
+            updateProgress(80, "[Queue] Dequeuing elements");
             m.deleteTime = measureTime([&]() {
-                for (const T& key : delKeys)
-                    map.remove(key);
-            });
+                size_t total = 0;
+                for (int i = 0; i < delCnt; i++) {
+                    total += queue.front() == T();
+                    queue.dequeue();
+                }
+                consume(total);
+            }, &m.deleteCounters);
             m.deleteCount = delCnt;
         }
 
-        // phase 5: memory
-        int elements = map.getSize();
-        int buckets = map.getCapacity();
-        m.memoryUsed = (buckets * sizeof(void*)) +
-                       (elements * (sizeof(T) + sizeof(V) + sizeof(void*)));
+        // phase 4: memory
+        m.memoryUsed = queue.getMemoryUsage();
+
+        // phase 5: total
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[Queue] Complete");
+        return m;
+    }
+
+    // test HashMap (chained by default, FlatHashing for open addressing);
+    // a non-zero rehashStep makes the chained map resize incrementally
+    template<typename V = T, typename Policy = ChainedHashing>
+    PerformanceMetrics testHashMap(const vector<T>& initialData,
+                                   const OperationProfile& profile,
+                                   const string& name = "HashMap",
+                                   int rehashStep = 0) {
+        PerformanceMetrics m(name);
+        m.dataSize = initialData.size();
+        HashMap<T, V, Policy> map;
+        if constexpr (is_same<Policy, ChainedHashing>::value)
+            map.setRehashStep(rehashStep);
+
+        string tag = "[" + name + "] ";
+        updateProgress(0, tag + "Starting test");
+
+        // phase 1: insert
+        updateProgress(5, tag + "Inserting initial data");
+        m.insertTime = measureTime([&]() {
+            for (const T& val : initialData)
+                map.insert(val, static_cast<V>(val));
+        }, &m.insertCounters);
+        m.insertCount = initialData.size();
+
+        // phase 2: interleaved searches, inserts and deletes
+        updateProgress(30, tag + "Running mixed operations");
+        vector<Operation<T>> ops = generateOperationStream(initialData, profile);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const T& key) { return map.search(key) != nullptr; },
+                [&](const T& key) { map.insert(key, static_cast<V>(key)); },
+                [&](const T& key) { map.remove(key); }));
+        });
+
+        // phase 3: memory (bucket/slot array plus entries, per policy)
+        m.memoryUsed = map.getMemoryUsage();
 
-        // phase 6: total
+        // phase 4: total
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
 
-        updateProgress(100, "[HashMap] Complete");
+        updateProgress(100, tag + "Complete");
         return m;
     }
 
@@ -341,57 +625,139 @@ public:
             for (size_t i = 1; i < initialData.size(); i++) {
                 graph.insert(initialData[i-1], initialData[i]);
             }
-        });
+        }, &m.insertCounters);
         m.insertCount = initialData.size();
 
-        // phase 2: search operations (vertex search)
-        int searchCnt = profile.getSearchCount();
-        if (searchCnt > 0) {
-            updateProgress(30, "[Graph] Performing searches");
-            vector<T> searchKeys = generateRandomKeys(initialData, searchCnt);
-            m.searchTime = measureTime([&]() {
-                for (const T& key : searchKeys)
-                    graph.search(key);
-            });
-            m.searchCount = searchCnt;
+        // phase 2: interleaved vertex searches, inserts and removals
+        updateProgress(30, "[Graph] Running mixed operations");
+        vector<Operation<T>> ops = generateOperationStream(initialData, profile);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const T& key) { return graph.search(key); },
+                [&](const T& key) { graph.insert(key); },
+                [&](const T& key) { graph.remove(key); }));
+        });
+
+        // phase 3: traversals from the first initial vertex that survived
+        for (const T& source : initialData) {
+            if (graph.search(source)) {
+                updateProgress(70, "[Graph] Running traversals");
+                m.traversalTime = measureTime([&]() {
+                    m.traversalCount = runGraphTraversals(graph, source);
+                }, &m.traversalCounters);
+                break;
+            }
         }
 
-        // phase 3: additional inserts (new vertices and edges)
-        int addInserts = profile.getInsertCount();
-        if (addInserts > 0) {
-            updateProgress(60, "[Graph] Additional inserts");
-            vector<T> newVals = generateNewValues(addInserts);
-            double addTime = measureTime([&]() {
-                for (const T& val : newVals)
-                    graph.insert(val);
-            });
-            m.insertTime += addTime;
-            m.insertCount += addInserts;
+        // phase 4: calculate memory
+        m.memoryUsed = graph.getMemoryUsage();
+
+        // phase 5: total time
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+
+        updateProgress(100, "[Graph] Complete");
+        return m;
+    }
+
+    // R-MAT generator (Graph500 parameters a=0.57, b=c=0.19): 2^scale
+    // vertices, edgeFactor edges per vertex, skewed power-law degrees
+    CSRGraph<uint32_t> powerLawGraph(int scale, int edgeFactor) {
+        vector<pair<uint32_t, uint32_t>> edges;
+        size_t edgeTotal = (size_t(1) << scale) * edgeFactor;
+        edges.reserve(edgeTotal);
+        uniform_real_distribution<double> coin(0.0, 1.0);
+        for (size_t e = 0; e < edgeTotal; e++) {
+            uint32_t u = 0, v = 0;
+            for (int bit = 0; bit < scale; bit++) {
+                double p = coin(rng);
+                if (p < 0.57) continue;
+                else if (p < 0.76) v |= 1u << bit;
+                else if (p < 0.95) u |= 1u << bit;
+                else { u |= 1u << bit; v |= 1u << bit; }
+            }
+            edges.push_back(make_pair(u, v));
         }
+        return CSRGraph<uint32_t>(edges, false);
+    }
 
-        // phase 4: delete operations (vertex removal)
-        int delCnt = profile.getDeleteCount();
-        if (delCnt > 0) {
-            updateProgress(80, "[Graph] Deleting vertices");
-            vector<T> delKeys = generateRandomKeys(initialData, delCnt);
-            m.deleteTime = measureTime([&]() {
-                for (const T& key : delKeys)
-                    graph.remove(key);
+    // direction-optimizing BFS from a few high-degree sources; reports
+    // traversed edges per second (edges inside the reached component)
+    PerformanceMetrics testParallelBfs(const CSRGraph<uint32_t>& graph, int threads) {
+        PerformanceMetrics m("BFS t=" + to_string(threads));
+        m.dataSize = graph.getVertexCount();
+
+        // the same sources for every thread count: the first vertices by id
+        // with a non-trivial degree
+        vector<uint32_t> sources;
+        for (uint32_t v = 0; v < (uint32_t)graph.getVertexCount() && sources.size() < 4; v++)
+            if (graph.degree(v) > 1) sources.push_back(v);
+
+        for (uint32_t s : sources) {
+            vector<uint32_t> level;
+            m.traversalTime += measureTime([&]() {
+                level = graph.parallelBfs(s, threads);
             });
-            m.deleteCount = delCnt;
+            long long arcs = 0;
+            for (uint32_t v = 0; v < level.size(); v++) {
+                if (level[v] != CSRGraph<uint32_t>::NoVertex) {
+                    m.traversalCount++;
+                    arcs += graph.degree(v);
+                }
+            }
+            m.edgesTraversed += arcs / 2;  // undirected: every edge is stored twice
         }
 
-        // phase 5: calculate memory
-        int vertices = graph.getVertexCount();
-        int edges = graph.getEdgeCount();
-        // Memory: adjacency list with map overhead + edge vectors
-        m.memoryUsed = vertices * (sizeof(T) + sizeof(vector<void*>)) + 
-                       edges * (sizeof(T) + sizeof(double));
+        m.memoryUsed = graph.getMemoryUsage();
+        m.totalTime = m.traversalTime;
+        return m;
+    }
 
-        // phase 6: total time
-        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+    // producer/consumer hand-off through a bounded concurrent queue: the
+    // items are split between the producers and every consumer dequeues a
+    // fixed share, so the run ends when all items have passed through;
+    // enqueue and dequeue throughput are both items over the wall-clock run
+    template<typename ConcurrentQ>
+    PerformanceMetrics testConcurrentQueue(const string& name, const vector<T>& items,
+                                           int producers, int consumers) {
+        PerformanceMetrics m(name);
+        m.dataSize = items.size();
+        ConcurrentQ queue(1024);
+        vector<size_t> totals(consumers, 0);
+
+        double elapsed = measureTime([&]() {
+            vector<thread> workers;
+            for (int p = 0; p < producers; p++) {
+                workers.emplace_back([&, p]() {
+                    for (size_t i = p; i < items.size(); i += producers)
+                        while (!queue.enqueue(items[i]))
+                            this_thread::yield();
+                });
+            }
+            for (int c = 0; c < consumers; c++) {
+                workers.emplace_back([&, c]() {
+                    size_t share = items.size() / consumers +
+                                   (size_t(c) < items.size() % consumers ? 1 : 0);
+                    T val;
+                    for (size_t i = 0; i < share; i++) {
+                        while (!queue.dequeue(val))
+                            this_thread::yield();
+                        totals[c] += val == T();
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+        });
 
-        updateProgress(100, "[Graph] Complete");
+        size_t total = 0;
+        for (size_t t : totals) total += t;
+        consume(total);
+
+        m.insertTime = elapsed;
+        m.insertCount = items.size();
+        m.deleteTime = elapsed;
+        m.deleteCount = items.size();
+        m.memoryUsed = queue.getMemoryUsage();
+        m.totalTime = elapsed;  // producers and consumers overlap
         return m;
     }
 
@@ -404,28 +770,70 @@ public:
         
         try {
             updateProgress(10, "Testing BST");
-            results["BST"] = testBST(dataset, profile);
+            results["BST"] = runTrials([&]() { return testBST(dataset, profile); });
         } catch (const exception& e) {
             cerr << "BST failed: " << e.what() << endl;
         }
 
+        // a frozen index only serves read-only workloads
+        if (profile.insertPercent == 0 && profile.deletePercent == 0) {
+            try {
+                updateProgress(25, "Testing FrozenBST");
+                results["FrozenBST"] = runTrials([&]() { return testFrozenBST(dataset, profile); });
+            } catch (const exception& e) {
+                cerr << "FrozenBST failed: " << e.what() << endl;
+            }
+        }
+
         try {
             updateProgress(40, "Testing HashMap");
-            results["HashMap"] = testHashMap(dataset, profile);
+            results["HashMap"] = runTrials([&]() { return testHashMap(dataset, profile); });
         } catch (const exception& e) {
             cerr << "HashMap failed: " << e.what() << endl;
         }
 
+        try {
+            updateProgress(55, "Testing FlatHashMap");
+            results["FlatHashMap"] = runTrials([&]() { return testHashMap<T, FlatHashing>(dataset, profile, "FlatHashMap"); });
+        } catch (const exception& e) {
+            cerr << "FlatHashMap failed: " << e.what() << endl;
+        }
+
+        try {
+            updateProgress(62, "Testing IncrementalHashMap");
+            results["IncrementalHashMap"] = runTrials([&]() {
+                return testHashMap<T, ChainedHashing>(dataset, profile, "IncrementalHashMap", 1);
+            });
+        } catch (const exception& e) {
+            cerr << "IncrementalHashMap failed: " << e.what() << endl;
+        }
+
         try {
             updateProgress(70, "Testing Heap");
-            results["Heap"] = testHeap(dataset, profile);
+            results["Heap"] = runTrials([&]() { return testHeap(dataset, profile); });
         } catch (const exception& e) {
             cerr << "Heap failed: " << e.what() << endl;
         }
 
+        if constexpr (is_integral<T>::value) {
+            try {
+                updateProgress(78, "Testing RadixHeap");
+                results["RadixHeap"] = runTrials([&]() { return testRadixHeap(dataset, profile); });
+            } catch (const exception& e) {
+                cerr << "RadixHeap failed: " << e.what() << endl;
+            }
+        }
+
+        try {
+            updateProgress(80, "Testing Queue");
+            results["Queue"] = runTrials([&]() { return testQueue(dataset, profile); });
+        } catch (const exception& e) {
+            cerr << "Queue failed: " << e.what() << endl;
+        }
+
         try {
             updateProgress(85, "Testing Graph");
-            results["Graph"] = testGraph(dataset, profile);
+            results["Graph"] = runTrials([&]() { return testGraph(dataset, profile); });
         } catch (const exception& e) {
             cerr << "Graph failed: " << e.what() << endl;
         }
@@ -434,6 +842,75 @@ public:
         return results;
     }
 
+    // run supplementary measurements of structure variants and extra query
+    // types; the GUI runs these after runAllTests and lists them on the
+    // results page, but they are not ranked
+    map<string, PerformanceMetrics> runExtendedTests(const vector<T>& dataset,
+                                                     const OperationProfile& profile) {
+        map<string, PerformanceMetrics> results;
+
+        updateProgress(0, "Starting extended tests");
+
+        try {
+            updateProgress(10, "Testing BST order statistics");
+            results["BST rank/select"] = testOrderStatistics(dataset, profile);
+        } catch (const exception& e) {
+            cerr << "BST rank/select failed: " << e.what() << endl;
+        }
+
+        try {
+            updateProgress(30, "Sweeping heap arity");
+            results["Heap d=2"] = testHeapArity<2>(dataset, profile);
+            results["Heap d=4"] = testHeapArity<4>(dataset, profile);
+            results["Heap d=8"] = testHeapArity<8>(dataset, profile);
+        } catch (const exception& e) {
+            cerr << "Heap arity sweep failed: " << e.what() << endl;
+        }
+
+        try {
+            updateProgress(60, "Sweeping BFS thread counts");
+            // power-law graph with at least as many vertices as the dataset
+            int scale = 16;
+            while ((size_t(1) << scale) < dataset.size()) scale++;
+            reseed(profile);
+            CSRGraph<uint32_t> graph = powerLawGraph(scale, 16);
+
+            unsigned hardware = max(1u, thread::hardware_concurrency());
+            for (unsigned threads = 1; ; threads *= 2) {
+                unsigned t = min(threads, hardware);
+                results["BFS t=" + to_string(t)] = testParallelBfs(graph, t);
+                if (t == hardware) break;
+            }
+        } catch (const exception& e) {
+            cerr << "BFS thread sweep failed: " << e.what() << endl;
+        }
+
+        try {
+            updateProgress(80, "Sweeping queue producer/consumer threads");
+            // enough items that thread start-up does not dominate
+            vector<T> items;
+            while (!dataset.empty() && items.size() < max(dataset.size(), size_t(1) << 20))
+                items.insert(items.end(), dataset.begin(), dataset.end());
+
+            results["SPSCQueue"] = testConcurrentQueue<SPSCQueue<T>>("SPSCQueue", items, 1, 1);
+
+            // producers and consumers run side by side, so each side gets
+            // half of the hardware threads at most
+            unsigned half = max(1u, thread::hardware_concurrency() / 2);
+            for (unsigned threads = 1; ; threads *= 2) {
+                unsigned t = min(threads, half);
+                string name = "MPMCQueue " + to_string(t) + "P/" + to_string(t) + "C";
+                results[name] = testConcurrentQueue<MPMCQueue<T>>(name, items, t, t);
+                if (t == half) break;
+            }
+        } catch (const exception& e) {
+            cerr << "Queue thread sweep failed: " << e.what() << endl;
+        }
+
+        updateProgress(100, "Extended tests complete");
+        return results;
+    }
+
     // save results to CSV
     bool saveResults(const string& filename,
                      const map<string, PerformanceMetrics>& results) {
@@ -443,8 +920,7 @@ public:
             return false;
         }
 
-        file << "Structure,DataSize,InsertTime(ms),SearchTime(ms),DeleteTime(ms),"
-             << "TotalTime(ms),MemoryUsed(bytes),MemoryPerElement(bytes)\n";
+        file << PerformanceMetrics::csvHeader() << "\n";
 
         for (const auto& pair : results) {
             file << pair.second.toCSV() << "\n";
@@ -521,6 +997,13 @@ public:
 private:
     mt19937 rng;
     ProgressCallback progressCallback;
+    int warmupRuns;
+    int repetitions;
+    PerfCounters perfCounters;
+    volatile size_t sink = 0;
+
+    // keep lookup results observable so timed loops are not optimised away
+    void consume(size_t value) { sink = value; }
 };
 
 // specialization for strings (includes Trie)
@@ -529,9 +1012,10 @@ class Benchmark<string> {
 public:
     struct OperationProfile {
         int searchPercent, insertPercent, deletePercent, totalOperations;
+        unsigned seed;  // fixes the operation stream, so runs are repeatable
 
-        OperationProfile(int s, int i, int d, int t)
-            : searchPercent(s), insertPercent(i), deletePercent(d), totalOperations(t) {
+        OperationProfile(int s, int i, int d, int t, unsigned seed = 42)
+            : searchPercent(s), insertPercent(i), deletePercent(d), totalOperations(t), seed(seed) {
             if (s + i + d != 100) throw invalid_argument("Must sum to 100");
             if (t <= 0) throw invalid_argument("Must be positive");
         }
@@ -546,25 +1030,62 @@ public:
             return "\nOperation Profile:\n  Search: " + to_string(searchPercent) + "% (" +
                    to_string(getSearchCount()) + " ops)\n  Insert: " + to_string(insertPercent) +
                    "% (" + to_string(getInsertCount()) + " ops)\n  Delete: " +
-                   to_string(deletePercent) + "% (" + to_string(getDeleteCount()) + " ops)\n";
+                   to_string(deletePercent) + "% (" + to_string(getDeleteCount()) + " ops)\n  Seed: " +
+                   to_string(seed) + "\n";
         }
     };
 
     using ProgressCallback = function<void(int, const string&)>;
 
-    Benchmark() : progressCallback(nullptr) {
+    Benchmark() : progressCallback(nullptr), warmupRuns(1), repetitions(5) {
         random_device rd;
         rng.seed(rd());
     }
 
     void setProgressCallback(ProgressCallback cb) { progressCallback = cb; }
 
+    // unmeasured warmup runs, then measured runs reported as medians
+    void setRepetitions(int warmup, int measured) {
+        if (warmup < 0 || measured < 1)
+            throw invalid_argument("Need at least one measured repetition");
+        warmupRuns = warmup;
+        repetitions = measured;
+    }
+
+    template<typename Test>
+    PerformanceMetrics runTrials(Test test) {
+        for (int i = 0; i < warmupRuns; i++) test();
+        vector<PerformanceMetrics> trials;
+        for (int i = 0; i < repetitions; i++) {
+            MemoryTracker::reset();
+            PerformanceMetrics m = test();
+            recordHeapUsage(m);
+            trials.push_back(m);
+        }
+        return PerformanceMetrics::aggregate(trials);
+    }
+
+    void setHardwareCounters(bool enabled) { perfCounters.setEnabled(enabled); }
+
+    // counter reads stay outside the timed region
+    template<typename Func>
+    double measureTime(Func f, HardwareCounters* counters = nullptr) {
+        MemoryTracker::Scope track;
+        double ms = 0.0;
+        auto timed = [&]() {
+            auto start = high_resolution_clock::now();
+            f();
+            auto end = high_resolution_clock::now();
+            ms = duration<double, milli>(end - start).count();
+        };
+        if (counters) countEvents(*counters, timed);
+        else timed();
+        return ms;
+    }
+
     template<typename Func>
-    double measureTime(Func f) {
-        auto start = high_resolution_clock::now();
-        f();
-        auto end = high_resolution_clock::now();
-        return duration<double, milli>(end - start).count();
+    void countEvents(HardwareCounters& into, Func f) {
+        into += perfCounters.measure(f);
     }
 
     vector<string> generateRandomKeys(const vector<string>& data, int cnt) {
@@ -582,6 +1103,20 @@ public:
         return vals;
     }
 
+    // tests that draw keys start from the profile's seed, whatever ran before
+    void reseed(const OperationProfile& prof) {
+        rng.seed(prof.seed);
+    }
+
+    // same stream for every structure: the rng is reseeded from the profile
+    vector<Operation<string>> generateOperationStream(const vector<string>& data,
+                                                      const OperationProfile& prof) {
+        reseed(prof);
+        auto vals = generateNewValues(prof.getInsertCount());
+        return buildOperationStream(prof.getSearchCount(), prof.getInsertCount(),
+                                    prof.getDeleteCount(), data, vals, rng);
+    }
+
     void updateProgress(int pct, const string& msg) {
         if (progressCallback) progressCallback(pct, msg);
     }
@@ -590,42 +1125,51 @@ public:
     PerformanceMetrics testBST(const vector<string>& data, const OperationProfile& prof) {
         PerformanceMetrics m("BST");
         m.dataSize = data.size();
-        BST<string> bst;
+        BST<string, AVLBalancing> bst;
 
         m.insertTime = measureTime([&]() {
             for (const auto& v : data) bst.insert(v);
+        }, &m.insertCounters);
+        m.insertCount = data.size();
+
+        auto ops = generateOperationStream(data, prof);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const string& k) { return bst.searchValue(k); },
+                [&](const string& v) { bst.insert(v); },
+                [&](const string& k) { bst.remove(k); }));
         });
+
+        m.memoryUsed = bst.getReservedBytes();
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+        return m;
+    }
+
+    PerformanceMetrics testFrozenBST(const vector<string>& data, const OperationProfile& prof) {
+        PerformanceMetrics m("FrozenBST");
+        m.dataSize = data.size();
+        StaticSearchTree<string> index;
+        reseed(prof);
+
+        m.insertTime = measureTime([&]() {
+            BST<string, AVLBalancing> bst;
+            for (const auto& v : data) bst.insert(v);
+            index = bst.freeze();
+        }, &m.insertCounters);
         m.insertCount = data.size();
 
         int sCnt = prof.getSearchCount();
         if (sCnt > 0) {
             auto keys = generateRandomKeys(data, sCnt);
             m.searchTime = measureTime([&]() {
-                for (const auto& k : keys) bst.searchValue(k);
-            });
+                size_t hits = 0;
+                for (const auto& k : keys) hits += index.searchValue(k);
+                consume(hits);
+            }, &m.searchCounters);
             m.searchCount = sCnt;
         }
 
-        int iCnt = prof.getInsertCount();
-        if (iCnt > 0) {
-            auto vals = generateNewValues(iCnt);
-            double t = measureTime([&]() {
-                for (const auto& v : vals) bst.insert(v);
-            });
-            m.insertTime += t;
-            m.insertCount += iCnt;
-        }
-
-        int dCnt = prof.getDeleteCount();
-        if (dCnt > 0) {
-            auto keys = generateRandomKeys(data, dCnt);
-            m.deleteTime = measureTime([&]() {
-                for (const auto& k : keys) bst.remove(k);
-            });
-            m.deleteCount = dCnt;
-        }
-
-        m.memoryUsed = bst.countNodes() * (sizeof(string) + 2*sizeof(void*) + sizeof(int));
+        m.memoryUsed = index.getMemoryUsage();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
         return m;
     }
@@ -633,128 +1177,111 @@ public:
     PerformanceMetrics testHeap(const vector<string>& data, const OperationProfile& prof) {
         PerformanceMetrics m("Heap");
         m.dataSize = data.size();
-        Heap<string> heap(false);
+        IndexedHeap<string> heap(false);
 
         m.insertTime = measureTime([&]() {
             for (const auto& v : data) heap.insert(v);
-        });
+        }, &m.insertCounters);
         m.insertCount = data.size();
 
-        int sCnt = prof.getSearchCount();
-        if (sCnt > 0) {
-            auto keys = generateRandomKeys(data, sCnt);
-            m.searchTime = measureTime([&]() {
-                for (const auto& k : keys) heap.search(k);
-            });
-            m.searchCount = sCnt;
-        }
+        auto ops = generateOperationStream(data, prof);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const string& k) { return heap.search(k); },
+                [&](const string& v) { heap.insert(v); },
+                [&](const string& k) { heap.removeValue(k); }));
+        });
+
+        m.memoryUsed = heap.getMemoryUsage();
+        m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
+        return m;
+    }
+
+    // FIFO workload: enqueue, then dequeue from the front; no search phase
+    PerformanceMetrics testQueue(const vector<string>& data, const OperationProfile& prof) {
+        PerformanceMetrics m("Queue");
+        m.dataSize = data.size();
+        Queue<string> queue;
+
+        m.insertTime = measureTime([&]() {
+            for (const auto& v : data) queue.enqueue(v);
+        }, &m.insertCounters);
+        m.insertCount = data.size();
 
         int iCnt = prof.getInsertCount();
         if (iCnt > 0) {
             auto vals = generateNewValues(iCnt);
             double t = measureTime([&]() {
-                for (const auto& v : vals) heap.insert(v);
-            });
+                for (auto& v : vals) queue.enqueue(std::move(v));
+            }, &m.insertCounters);
             m.insertTime += t;
             m.insertCount += iCnt;
         }
 
-        int dCnt = prof.getDeleteCount();
+        int dCnt = min(prof.getDeleteCount(), queue.size());
         if (dCnt > 0) {
-            auto keys = generateRandomKeys(data, dCnt);
             m.deleteTime = measureTime([&]() {
-                for (const auto& k : keys) heap.removeValue(k);
-            });
+                size_t total = 0;
+                for (int i = 0; i < dCnt; i++) {
+                    total += queue.front().size();
+                    queue.dequeue();
+                }
+                consume(total);
+            }, &m.deleteCounters);
             m.deleteCount = dCnt;
         }
 
-        m.memoryUsed = heap.size() * sizeof(string);
+        m.memoryUsed = queue.getMemoryUsage();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
         return m;
     }
 
-    PerformanceMetrics testHashMap(const vector<string>& data, const OperationProfile& prof) {
-        PerformanceMetrics m("HashMap");
+    template<typename Policy = ChainedHashing>
+    PerformanceMetrics testHashMap(const vector<string>& data, const OperationProfile& prof,
+                                   const string& name = "HashMap", int rehashStep = 0) {
+        PerformanceMetrics m(name);
         m.dataSize = data.size();
-        HashMap<string, string> map;
+        HashMap<string, string, Policy> map;
+        if constexpr (is_same<Policy, ChainedHashing>::value)
+            map.setRehashStep(rehashStep);
 
         m.insertTime = measureTime([&]() {
             for (const auto& v : data) map.insert(v, v);
-        });
+        }, &m.insertCounters);
         m.insertCount = data.size();
 
-        int sCnt = prof.getSearchCount();
-        if (sCnt > 0) {
-            auto keys = generateRandomKeys(data, sCnt);
-            m.searchTime = measureTime([&]() {
-                for (const auto& k : keys) map.search(k);
-            });
-            m.searchCount = sCnt;
-        }
-
-        int iCnt = prof.getInsertCount();
-        if (iCnt > 0) {
-            auto vals = generateNewValues(iCnt);
-            double t = measureTime([&]() {
-                for (const auto& v : vals) map.insert(v, v);
-            });
-            m.insertTime += t;
-            m.insertCount += iCnt;
-        }
-
-        int dCnt = prof.getDeleteCount();
-        if (dCnt > 0) {
-            auto keys = generateRandomKeys(data, dCnt);
-            m.deleteTime = measureTime([&]() {
-                for (const auto& k : keys) map.remove(k);
-            });
-            m.deleteCount = dCnt;
-        }
+        auto ops = generateOperationStream(data, prof);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const string& k) { return map.search(k) != nullptr; },
+                [&](const string& v) { map.insert(v, v); },
+                [&](const string& k) { map.remove(k); }));
+        });
 
-        int elem = map.getSize();
-        int buck = map.getCapacity();
-        m.memoryUsed = (buck * sizeof(void*)) + (elem * (2*sizeof(string) + sizeof(void*)));
+        m.memoryUsed = map.getMemoryUsage();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
         return m;
     }
 
-    PerformanceMetrics testTrie(const vector<string>& data, const OperationProfile& prof) {
-        PerformanceMetrics m("Trie");
+    // compressed = true benchmarks the path-compressed (radix) mode
+    PerformanceMetrics testTrie(const vector<string>& data, const OperationProfile& prof,
+                                bool compressed = false, const string& name = "Trie") {
+        PerformanceMetrics m(name);
         m.dataSize = data.size();
-        Trie trie;
+        Trie trie(compressed);
 
         m.insertTime = measureTime([&]() {
             for (const auto& v : data) trie.insert(v);
-        });
+        }, &m.insertCounters);
         m.insertCount = data.size();
 
-        int sCnt = prof.getSearchCount();
-        if (sCnt > 0) {
-            auto keys = generateRandomKeys(data, sCnt);
-            m.searchTime = measureTime([&]() {
-                for (const auto& k : keys) trie.search(k);
-            });
-            m.searchCount = sCnt;
-        }
-
-        int iCnt = prof.getInsertCount();
-        if (iCnt > 0) {
-            auto vals = generateNewValues(iCnt);
-            double t = measureTime([&]() {
-                for (const auto& v : vals) trie.insert(v);
-            });
-            m.insertTime += t;
-            m.insertCount += iCnt;
-        }
-
-        int dCnt = prof.getDeleteCount();
-        if (dCnt > 0) {
-            auto keys = generateRandomKeys(data, dCnt);
-            m.deleteTime = measureTime([&]() {
-                for (const auto& k : keys) trie.remove(k);
-            });
-            m.deleteCount = dCnt;
-        }
+        auto ops = generateOperationStream(data, prof);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const string& k) { return trie.search(k); },
+                [&](const string& v) { trie.insert(v); },
+                [&](const string& k) { trie.remove(k); }));
+        });
 
         m.memoryUsed = trie.estimateMemory();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
@@ -773,41 +1300,28 @@ public:
             for (size_t i = 1; i < data.size(); i++) {
                 graph.insert(data[i-1], data[i]);
             }
-        });
+        }, &m.insertCounters);
         m.insertCount = data.size();
 
-        int sCnt = prof.getSearchCount();
-        if (sCnt > 0) {
-            auto keys = generateRandomKeys(data, sCnt);
-            m.searchTime = measureTime([&]() {
-                for (const auto& k : keys) graph.search(k);
-            });
-            m.searchCount = sCnt;
-        }
-
-        int iCnt = prof.getInsertCount();
-        if (iCnt > 0) {
-            auto vals = generateNewValues(iCnt);
-            double t = measureTime([&]() {
-                for (const auto& v : vals) graph.insert(v);
-            });
-            m.insertTime += t;
-            m.insertCount += iCnt;
-        }
+        auto ops = generateOperationStream(data, prof);
+        countEvents(m.mixedCounters, [&]() {
+            consume(runOperationStream(ops, m,
+                [&](const string& k) { return graph.search(k); },
+                [&](const string& v) { graph.insert(v); },
+                [&](const string& k) { graph.remove(k); }));
+        });
 
-        int dCnt = prof.getDeleteCount();
-        if (dCnt > 0) {
-            auto keys = generateRandomKeys(data, dCnt);
-            m.deleteTime = measureTime([&]() {
-                for (const auto& k : keys) graph.remove(k);
-            });
-            m.deleteCount = dCnt;
+        // traverse from the first initial vertex that survived the removals
+        for (const auto& source : data) {
+            if (graph.search(source)) {
+                m.traversalTime = measureTime([&]() {
+                    m.traversalCount = runGraphTraversals(graph, source);
+                }, &m.traversalCounters);
+                break;
+            }
         }
 
-        int vertices = graph.getVertexCount();
-        int edges = graph.getEdgeCount();
-        m.memoryUsed = vertices * (sizeof(string) + sizeof(vector<void*>)) + 
-                       edges * (sizeof(string) + sizeof(double));
+        m.memoryUsed = graph.getMemoryUsage();
         m.totalTime = m.insertTime + m.searchTime + m.deleteTime;
         return m;
     }
@@ -815,29 +1329,51 @@ public:
     map<string, PerformanceMetrics> runAllTests(const vector<string>& data, const OperationProfile& prof) {
         map<string, PerformanceMetrics> results;
 
-        try { results["BST"] = testBST(data, prof); }
+        try { results["BST"] = runTrials([&]() { return testBST(data, prof); }); }
         catch (const exception& e) { cerr << "BST failed: " << e.what() << endl; }
 
-        try { results["HashMap"] = testHashMap(data, prof); }
+        if (prof.insertPercent == 0 && prof.deletePercent == 0) {
+            try { results["FrozenBST"] = runTrials([&]() { return testFrozenBST(data, prof); }); }
+            catch (const exception& e) { cerr << "FrozenBST failed: " << e.what() << endl; }
+        }
+
+        try { results["HashMap"] = runTrials([&]() { return testHashMap(data, prof); }); }
         catch (const exception& e) { cerr << "HashMap failed: " << e.what() << endl; }
 
-        try { results["Heap"] = testHeap(data, prof); }
+        try { results["FlatHashMap"] = runTrials([&]() { return testHashMap<FlatHashing>(data, prof, "FlatHashMap"); }); }
+        catch (const exception& e) { cerr << "FlatHashMap failed: " << e.what() << endl; }
+
+        try { results["IncrementalHashMap"] = runTrials([&]() { return testHashMap(data, prof, "IncrementalHashMap", 1); }); }
+        catch (const exception& e) { cerr << "IncrementalHashMap failed: " << e.what() << endl; }
+
+        try { results["Heap"] = runTrials([&]() { return testHeap(data, prof); }); }
         catch (const exception& e) { cerr << "Heap failed: " << e.what() << endl; }
 
-        try { results["Trie"] = testTrie(data, prof); }
+        try { results["Queue"] = runTrials([&]() { return testQueue(data, prof); }); }
+        catch (const exception& e) { cerr << "Queue failed: " << e.what() << endl; }
+
+        try { results["Trie"] = runTrials([&]() { return testTrie(data, prof); }); }
         catch (const exception& e) { cerr << "Trie failed: " << e.what() << endl; }
 
-        try { results["Graph"] = testGraph(data, prof); }
+        try { results["RadixTrie"] = runTrials([&]() { return testTrie(data, prof, true, "RadixTrie"); }); }
+        catch (const exception& e) { cerr << "RadixTrie failed: " << e.what() << endl; }
+
+        try { results["Graph"] = runTrials([&]() { return testGraph(data, prof); }); }
         catch (const exception& e) { cerr << "Graph failed: " << e.what() << endl; }
 
         return results;
     }
 
+    // same interface as Benchmark<T>; the extended variants and sweeps
+    // (order statistics, heap arity, BFS and queue threads) are integer-only
+    map<string, PerformanceMetrics> runExtendedTests(const vector<string>&, const OperationProfile&) {
+        return map<string, PerformanceMetrics>();
+    }
+
     bool saveResults(const string& file, const map<string, PerformanceMetrics>& res) {
         ofstream f(file);
         if (!f.is_open()) return false;
-        f << "Structure,DataSize,InsertTime(ms),SearchTime(ms),DeleteTime(ms),"
-          << "TotalTime(ms),MemoryUsed(bytes),MemoryPerElement(bytes)\n";
+        f << PerformanceMetrics::csvHeader() << "\n";
         for (const auto& p : res) f << p.second.toCSV() << "\n";
         f.close();
         return true;
@@ -866,5 +1402,12 @@ public:
 private:
     mt19937 rng;
     ProgressCallback progressCallback;
+    int warmupRuns;
+    int repetitions;
+    PerfCounters perfCounters;
+    volatile size_t sink = 0;
+
+    // keep lookup results observable so timed loops are not optimised away
+    void consume(size_t value) { sink = value; }
 };
 #endif
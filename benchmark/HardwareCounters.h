@@ -0,0 +1,188 @@
+#ifndef HARDWARECOUNTERS_H
+#define HARDWARECOUNTERS_H
+
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace std;
+
+// hardware event counts for one benchmark phase
+// an event the CPU, kernel or hypervisor does not provide stays 0;
+// recorded is false when no counter could be read at all
+struct HardwareCounters {
+    long long cycles;
+    long long instructions;
+    long long l1dMisses;     // L1 data cache read misses
+    long long llcMisses;     // last-level cache misses
+    long long branchMisses;
+    bool recorded;
+
+    HardwareCounters()
+        : cycles(0), instructions(0), l1dMisses(0), llcMisses(0),
+          branchMisses(0), recorded(false) {}
+
+    HardwareCounters& operator+=(const HardwareCounters& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        l1dMisses += other.l1dMisses;
+        llcMisses += other.llcMisses;
+        branchMisses += other.branchMisses;
+        recorded = recorded || other.recorded;
+        return *this;
+    }
+
+    // instructions per cycle
+    double getIPC() const {
+        return cycles > 0 ? static_cast<double>(instructions) / cycles : 0.0;
+    }
+
+    string toString() const {
+        return to_string(cycles) + " cycles, " + to_string(instructions) + " instructions (IPC " +
+               to_string(getIPC()) + "), " + to_string(l1dMisses) + " L1D misses, " +
+               to_string(llcMisses) + " LLC misses, " + to_string(branchMisses) + " branch misses";
+    }
+};
+
+// reads the counters above through Linux perf_event_open for the calling
+// thread, user space only (allowed up to perf_event_paranoid 2). The events
+// are opened lazily and reopened when a different thread measures, since
+// the GUI builds the benchmark on one thread and runs it on another
+// when the kernel refuses every event, or off Linux, isAvailable() is false
+// and measure() returns an unrecorded sample: timing-only
+class PerfCounters {
+public:
+    static constexpr int EventCount = 5;
+
+    PerfCounters() : enabled(true), opened(false) {
+        for (int i = 0; i < EventCount; i++) fds[i] = -1;
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+        closeAll();
+    }
+
+    void setEnabled(bool on) {
+        enabled = on;
+        if (!on) closeAll();
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    // true when at least one event can be read on this thread
+    bool isAvailable() {
+        ensureOpen();
+        for (int i = 0; i < EventCount; i++)
+            if (fds[i] >= 0) return true;
+        return false;
+    }
+
+    // run f and return the events it caused
+    template<typename Func>
+    HardwareCounters measure(Func f) {
+        HardwareCounters result;
+        if (!enabled || !isAvailable()) {
+            f();
+            return result;
+        }
+
+        Reading before[EventCount], after[EventCount];
+        readAll(before);
+        f();
+        readAll(after);
+
+        long long* values[EventCount] = {
+            &result.cycles, &result.instructions, &result.l1dMisses,
+            &result.llcMisses, &result.branchMisses
+        };
+        for (int i = 0; i < EventCount; i++) {
+            if (fds[i] < 0) continue;
+            unsigned long long running = after[i].running - before[i].running;
+            unsigned long long enabledTime = after[i].enabled - before[i].enabled;
+            if (running == 0) continue;
+            // scale up when the kernel multiplexed the counter
+            double delta = static_cast<double>(after[i].value - before[i].value);
+            *values[i] = static_cast<long long>(delta * enabledTime / running);
+            result.recorded = true;
+        }
+        return result;
+    }
+
+private:
+    struct Reading {
+        unsigned long long value;
+        unsigned long long enabled;
+        unsigned long long running;
+    };
+
+    int fds[EventCount];
+    bool enabled;
+    bool opened;
+    thread::id owner;
+
+    void ensureOpen() {
+        if (opened && owner == this_thread::get_id())
+            return;
+        closeAll();
+        owner = this_thread::get_id();
+        opened = true;
+#ifdef __linux__
+        const unsigned long long l1dReadMiss =
+            PERF_COUNT_HW_CACHE_L1D |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const struct { unsigned type; unsigned long long config; } events[EventCount] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, l1dReadMiss},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+        };
+        for (int i = 0; i < EventCount; i++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].type;
+            attr.config = events[i].config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    void readAll(Reading (&readings)[EventCount]) {
+        for (int i = 0; i < EventCount; i++) {
+            readings[i] = Reading{0, 0, 0};
+#ifdef __linux__
+            if (fds[i] >= 0 && read(fds[i], &readings[i], sizeof(Reading)) != sizeof(Reading))
+                readings[i] = Reading{0, 0, 0};
+#endif
+        }
+    }
+
+    void closeAll() {
+        for (int i = 0; i < EventCount; i++) {
+#ifdef __linux__
+            if (fds[i] >= 0) close(fds[i]);
+#endif
+            fds[i] = -1;
+        }
+        opened = false;
+    }
+};
+
+#endif
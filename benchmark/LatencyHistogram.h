@@ -0,0 +1,110 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+// log-bucketed latency histogram (HDR style) over nanoseconds
+// values below 16 ns get a bucket each; above that every power of two is
+// split into 16 linear sub-buckets, so a recorded value is known to within
+// 1/16 of its magnitude whatever its size. Recording is a bit scan and an
+// increment; the bucket array is allocated on the first sample or by
+// reserve()
+class LatencyHistogram {
+private:
+    static constexpr int SubBits = 4;
+    static constexpr int SubBuckets = 1 << SubBits;
+    static constexpr int BucketCount = (64 - SubBits + 1) * SubBuckets;
+
+    vector<uint64_t> counts;
+    long long total;
+
+    static int highestBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(x);
+#else
+        int b = -1;
+        while (x) { x >>= 1; b++; }
+        return b;
+#endif
+    }
+
+    static int bucketOf(uint64_t nanos) {
+        if (nanos < SubBuckets)
+            return static_cast<int>(nanos);
+        int exponent = highestBit(nanos);
+        int sub = static_cast<int>((nanos >> (exponent - SubBits)) & (SubBuckets - 1));
+        return (exponent - SubBits + 1) * SubBuckets + sub;
+    }
+
+    // smallest value that falls into bucket
+    static double lowerBound(int bucket) {
+        if (bucket < SubBuckets)
+            return bucket;
+        int exponent = bucket / SubBuckets + SubBits - 1;
+        int sub = bucket % SubBuckets;
+        return ldexp(SubBuckets + sub, exponent - SubBits);
+    }
+
+public:
+    LatencyHistogram() : total(0) {}
+
+    // allocate the bucket array now, so a later record() never allocates
+    // (keeps the histogram out of MemoryTracker scopes it records inside)
+    void reserve() {
+        if (counts.empty())
+            counts.assign(BucketCount, 0);
+    }
+
+    // add one sample
+    void record(uint64_t nanos) {
+        reserve();
+        counts[bucketOf(nanos)]++;
+        total++;
+    }
+
+    // add all samples of other
+    void merge(const LatencyHistogram& other) {
+        if (other.total == 0)
+            return;
+        reserve();
+        for (int i = 0; i < BucketCount; i++)
+            counts[i] += other.counts[i];
+        total += other.total;
+    }
+
+    void clear() {
+        counts.clear();
+        total = 0;
+    }
+
+    long long getCount() const {
+        return total;
+    }
+
+    // value at percentile p (0-100) in nanoseconds: the midpoint of the
+    // bucket holding the sample of that rank, 0 when empty
+    double percentile(double p) const {
+        if (total == 0)
+            return 0.0;
+        long long rank = static_cast<long long>(ceil(p / 100.0 * total));
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+
+        long long seen = 0;
+        for (int i = 0; i < BucketCount; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                if (i < SubBuckets)
+                    return i;
+                return (lowerBound(i) + lowerBound(i + 1)) / 2.0;
+            }
+        }
+        return lowerBound(BucketCount - 1);
+    }
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "MemoryTracker.h"
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+// replacement global operator new/delete reporting to MemoryTracker
+// every block carries a 16-byte header in front of the returned pointer
+// with the requested size, the tracking epoch and the distance back to the
+// malloc'd address (larger than the header for over-aligned blocks), so
+// any delete form can report the size and free the right address
+
+namespace {
+
+struct BlockHeader {
+    size_t size;
+    uint32_t epoch;
+    uint32_t offset;  // returned pointer minus malloc'd pointer
+};
+
+constexpr size_t HeaderSize = 16;
+static_assert(sizeof(BlockHeader) <= HeaderSize, "block header must fit in 16 bytes");
+
+BlockHeader* headerOf(void* p) {
+    return reinterpret_cast<BlockHeader*>(static_cast<char*>(p) - HeaderSize);
+}
+
+// nullptr on failure; malloc's alignment survives the 16-byte header, only
+// over-aligned requests need padding
+void* allocateBlock(size_t size, size_t alignment) {
+    bool overAligned = alignment > alignof(max_align_t);
+    size_t extra = HeaderSize + (overAligned ? alignment : 0);
+
+    void* raw;
+    while ((raw = malloc(size + extra)) == nullptr) {
+        new_handler handler = get_new_handler();
+        if (!handler)
+            return nullptr;
+        handler();
+    }
+
+    uintptr_t aligned = reinterpret_cast<uintptr_t>(raw) + HeaderSize;
+    if (overAligned)
+        aligned = (aligned + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    void* p = reinterpret_cast<void*>(aligned);
+
+    BlockHeader* header = headerOf(p);
+    header->size = size;
+    header->offset = static_cast<uint32_t>(aligned - reinterpret_cast<uintptr_t>(raw));
+    header->epoch = MemoryTracker::onAllocate(size);
+    return p;
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    void* p = allocateBlock(size, alignment);
+    if (!p)
+        throw bad_alloc();
+    return p;
+}
+
+void freeBlock(void* p) {
+    if (!p)
+        return;
+    BlockHeader* header = headerOf(p);
+    MemoryTracker::onDeallocate(header->size, header->epoch);
+    free(static_cast<char*>(p) - header->offset);
+}
+
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return allocateBlock(size, 0); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return allocateBlock(size, 0); }
+
+void* operator new(size_t size, align_val_t al) { return allocateOrThrow(size, size_t(al)); }
+void* operator new[](size_t size, align_val_t al) { return allocateOrThrow(size, size_t(al)); }
+void* operator new(size_t size, align_val_t al, const nothrow_t&) noexcept { return allocateBlock(size, size_t(al)); }
+void* operator new[](size_t size, align_val_t al, const nothrow_t&) noexcept { return allocateBlock(size, size_t(al)); }
+
+void operator delete(void* p) noexcept { freeBlock(p); }
+void operator delete[](void* p) noexcept { freeBlock(p); }
+void operator delete(void* p, size_t) noexcept { freeBlock(p); }
+void operator delete[](void* p, size_t) noexcept { freeBlock(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { freeBlock(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { freeBlock(p); }
+
+void operator delete(void* p, align_val_t) noexcept { freeBlock(p); }
+void operator delete[](void* p, align_val_t) noexcept { freeBlock(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { freeBlock(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { freeBlock(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { freeBlock(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { freeBlock(p); }
@@ -0,0 +1,101 @@
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// heap accounting for benchmarks: MemoryTracker.cpp replaces the global
+// operator new/delete and reports every allocation here. Only threads
+// inside a Scope are counted, so the GUI thread and the test's own key
+// vectors stay out of the numbers; a block is subtracted again only if it
+// was counted since the last reset(), so frees of older blocks don't skew
+// the live total
+// without MemoryTracker.cpp linked in, nothing is reported and
+// getAllocationCount() stays 0
+class MemoryTracker {
+public:
+    // counts allocations on this thread while alive; nests
+    class Scope {
+    public:
+        Scope() { depth()++; }
+        ~Scope() { depth()--; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // zero the counters and start a new epoch
+    static void reset() {
+        liveBytes().store(0, memory_order_relaxed);
+        peakBytes().store(0, memory_order_relaxed);
+        allocations().store(0, memory_order_relaxed);
+        epoch().fetch_add(1, memory_order_relaxed);
+    }
+
+    // bytes allocated inside scopes and not yet freed inside scopes
+    static size_t getLiveBytes() {
+        long long live = liveBytes().load(memory_order_relaxed);
+        return live > 0 ? static_cast<size_t>(live) : 0;
+    }
+
+    // highest live total since reset()
+    static size_t getPeakBytes() {
+        return static_cast<size_t>(peakBytes().load(memory_order_relaxed));
+    }
+
+    static long long getAllocationCount() {
+        return allocations().load(memory_order_relaxed);
+    }
+
+    // allocation hook: returns the epoch to store with the block, 0 when
+    // this thread is not being tracked
+    static uint32_t onAllocate(size_t size) {
+        if (depth() == 0)
+            return 0;
+        allocations().fetch_add(1, memory_order_relaxed);
+        long long live = liveBytes().fetch_add(size, memory_order_relaxed) + size;
+        long long peak = peakBytes().load(memory_order_relaxed);
+        while (live > peak &&
+               !peakBytes().compare_exchange_weak(peak, live, memory_order_relaxed)) {
+        }
+        return epoch().load(memory_order_relaxed);
+    }
+
+    // deallocation hook, with the epoch onAllocate returned for the block
+    static void onDeallocate(size_t size, uint32_t blockEpoch) {
+        if (depth() == 0 || blockEpoch != epoch().load(memory_order_relaxed))
+            return;
+        liveBytes().fetch_sub(size, memory_order_relaxed);
+    }
+
+private:
+    static int& depth() {
+        static thread_local int value = 0;
+        return value;
+    }
+
+    static atomic<long long>& liveBytes() {
+        static atomic<long long> value(0);
+        return value;
+    }
+
+    static atomic<long long>& peakBytes() {
+        static atomic<long long> value(0);
+        return value;
+    }
+
+    static atomic<long long>& allocations() {
+        static atomic<long long> value(0);
+        return value;
+    }
+
+    // starts at 1: epoch 0 marks blocks allocated while untracked
+    static atomic<uint32_t>& epoch() {
+        static atomic<uint32_t> value(1);
+        return value;
+    }
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef OPERATIONSTREAM_H
+#define OPERATIONSTREAM_H
+
+#include "PerformanceMetrics.h"
+#include "MemoryTracker.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+// interleaved workload shared by both Benchmark classes: the profile's
+// searches, inserts and deletes are shuffled into one stream and executed in
+// a single loop, so lookups run against the rehashes, rebalancing and
+// deletions caused by the updates around them
+
+enum class OperationType : uint8_t { Search, Insert, Delete };
+
+template<typename T>
+struct Operation {
+    OperationType type;
+    T key;
+};
+
+// shuffle the operation counts into one stream; search and delete keys are
+// drawn from existing, insert keys are taken from newValues in order
+template<typename T>
+vector<Operation<T>> buildOperationStream(int searches, int inserts, int deletes,
+                                          const vector<T>& existing,
+                                          const vector<T>& newValues,
+                                          mt19937& rng) {
+    if (existing.empty()) {
+        searches = 0;
+        deletes = 0;
+    }
+    inserts = min(inserts, static_cast<int>(newValues.size()));
+
+    vector<OperationType> types;
+    types.reserve(searches + inserts + deletes);
+    types.insert(types.end(), searches, OperationType::Search);
+    types.insert(types.end(), inserts, OperationType::Insert);
+    types.insert(types.end(), deletes, OperationType::Delete);
+    shuffle(types.begin(), types.end(), rng);
+
+    vector<Operation<T>> stream;
+    stream.reserve(types.size());
+    uniform_int_distribution<size_t> pick(0, existing.empty() ? 0 : existing.size() - 1);
+    size_t nextInsert = 0;
+    for (OperationType type : types) {
+        if (type == OperationType::Insert)
+            stream.push_back({type, newValues[nextInsert++]});
+        else
+            stream.push_back({type, existing[pick(rng)]});
+    }
+    return stream;
+}
+
+// run the stream in one loop, timing every operation and charging it to its
+// type and that type's latency histogram; one clock read per operation (the
+// end of one is the start of the next), so the loop overhead is spread
+// evenly over all types
+// search returns whether the key was found; the hit count is returned so
+// callers can keep it observable
+template<typename T, typename SearchFn, typename InsertFn, typename DeleteFn>
+size_t runOperationStream(const vector<Operation<T>>& stream, PerformanceMetrics& m,
+                          SearchFn search, InsertFn insert, DeleteFn remove) {
+    using Clock = chrono::steady_clock;
+    LatencyHistogram* latency[3] = {&m.searchLatency, &m.insertLatency, &m.deleteLatency};
+    long long nanos[3] = {0, 0, 0};
+    int counts[3] = {0, 0, 0};
+    size_t hits = 0;
+    // histogram storage is allocated before tracking starts, so only the
+    // structure's own allocations are charged to it
+    for (LatencyHistogram* histogram : latency)
+        histogram->reserve();
+    MemoryTracker::Scope track;
+
+    Clock::time_point last = Clock::now();
+    for (const Operation<T>& op : stream) {
+        switch (op.type) {
+            case OperationType::Search: hits += search(op.key); break;
+            case OperationType::Insert: insert(op.key); break;
+            case OperationType::Delete: remove(op.key); break;
+        }
+        Clock::time_point now = Clock::now();
+        int type = static_cast<int>(op.type);
+        long long elapsed = chrono::duration_cast<chrono::nanoseconds>(now - last).count();
+        latency[type]->record(static_cast<uint64_t>(elapsed));
+        nanos[type] += elapsed;
+        counts[type]++;
+        last = now;
+    }
+
+    m.searchTime += nanos[0] / 1e6;
+    m.insertTime += nanos[1] / 1e6;
+    m.deleteTime += nanos[2] / 1e6;
+    m.searchCount += counts[0];
+    m.insertCount += counts[1];
+    m.deleteCount += counts[2];
+    return hits;
+}
+
+#endif
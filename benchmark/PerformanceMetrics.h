@@ -9,6 +9,10 @@
 #include <sstream>
 #include <locale>
 #include <iomanip>
+#include <vector>
+#include "LatencyHistogram.h"
+#include "TrialStats.h"
+#include "HardwareCounters.h"
 
 using namespace std;
 
@@ -19,14 +23,39 @@ public:
     double searchTime;
     double deleteTime;
     double totalTime;
+    double traversalTime;  // graph traversals (BFS, DFS, shortest paths, components), not in totalTime
 
     // operation counts
     int insertCount;
     int searchCount;
     int deleteCount;
+    long long traversalCount;  // vertices visited across all traversals
+    long long edgesTraversed;  // edges inside the traversed components (for TEPS)
+
+    // per-operation latencies of the interleaved operation stream
+    LatencyHistogram insertLatency;
+    LatencyHistogram searchLatency;
+    LatencyHistogram deleteLatency;
+
+    // hardware events per phase (recorded only where perf counters are
+    // available); mixed is the interleaved operation stream
+    HardwareCounters insertCounters;
+    HardwareCounters searchCounters;
+    HardwareCounters deleteCounters;
+    HardwareCounters mixedCounters;
+    HardwareCounters traversalCounters;
+
+    // spread over repeated trials; the time fields above hold the medians
+    int repetitions;
+    TrialStats insertTimeStats;
+    TrialStats searchTimeStats;
+    TrialStats deleteTimeStats;
+    TrialStats totalTimeStats;
 
     // memory usage in bytes
     size_t memoryUsed;
+    size_t peakMemory;          // highest live heap bytes during the test (0 if not tracked)
+    long long allocationCount;  // heap allocations made by the structure (0 if not tracked)
 
     // metadata
     string structureName;
@@ -35,13 +64,73 @@ public:
 
     // constructor
     PerformanceMetrics(string name = "Unknown") : structureName(name) {
-        insertTime = searchTime = deleteTime = totalTime = 0.0;
+        insertTime = searchTime = deleteTime = totalTime = traversalTime = 0.0;
         insertCount = searchCount = deleteCount = 0;
+        traversalCount = 0;
+        edgesTraversed = 0;
+        repetitions = 1;
         memoryUsed = 0;
+        peakMemory = 0;
+        allocationCount = 0;
         dataSize = 0;
         score = 0.0;
     }
 
+    // combine repeated trials of one structure: times become the medians
+    // with their spread in the *Stats fields, latency histograms are merged,
+    // hardware counters are averaged, counts and memory come from the first
+    // trial
+    static PerformanceMetrics aggregate(const vector<PerformanceMetrics>& trials) {
+        if (trials.empty())
+            return PerformanceMetrics();
+
+        PerformanceMetrics m = trials[0];
+        m.insertLatency.clear();
+        m.searchLatency.clear();
+        m.deleteLatency.clear();
+
+        vector<double> inserts, searches, deletes, totals, traversals;
+        for (const PerformanceMetrics& t : trials) {
+            inserts.push_back(t.insertTime);
+            searches.push_back(t.searchTime);
+            deletes.push_back(t.deleteTime);
+            totals.push_back(t.totalTime);
+            traversals.push_back(t.traversalTime);
+            m.insertLatency.merge(t.insertLatency);
+            m.searchLatency.merge(t.searchLatency);
+            m.deleteLatency.merge(t.deleteLatency);
+        }
+
+        m.repetitions = static_cast<int>(trials.size());
+        m.insertTimeStats = TrialStats::of(inserts);
+        m.searchTimeStats = TrialStats::of(searches);
+        m.deleteTimeStats = TrialStats::of(deletes);
+        m.totalTimeStats = TrialStats::of(totals);
+        m.insertTime = m.insertTimeStats.median;
+        m.searchTime = m.searchTimeStats.median;
+        m.deleteTime = m.deleteTimeStats.median;
+        m.totalTime = m.totalTimeStats.median;
+        m.traversalTime = TrialStats::of(traversals).median;
+
+        HardwareCounters PerformanceMetrics::* phases[] = {
+            &PerformanceMetrics::insertCounters, &PerformanceMetrics::searchCounters,
+            &PerformanceMetrics::deleteCounters, &PerformanceMetrics::mixedCounters,
+            &PerformanceMetrics::traversalCounters
+        };
+        long long n = static_cast<long long>(trials.size());
+        for (auto phase : phases) {
+            HardwareCounters sum;
+            for (const PerformanceMetrics& t : trials) sum += t.*phase;
+            sum.cycles /= n;
+            sum.instructions /= n;
+            sum.l1dMisses /= n;
+            sum.llcMisses /= n;
+            sum.branchMisses /= n;
+            m.*phase = sum;
+        }
+        return m;
+    }
+
     // calculate average times
     double getAverageInsertTime() const {
         return insertCount > 0 ? insertTime / insertCount : 0.0;
@@ -55,6 +144,10 @@ public:
         return deleteCount > 0 ? deleteTime / deleteCount : 0.0;
     }
 
+    double getAverageTraversalTime() const {
+        return traversalCount > 0 ? traversalTime / traversalCount : 0.0;
+    }
+
     // operations per second
     double getInsertThroughput() const {
         return insertTime > 0 ? (insertCount / insertTime) * 1000.0 : 0.0;
@@ -68,6 +161,39 @@ public:
         return deleteTime > 0 ? (deleteCount / deleteTime) * 1000.0 : 0.0;
     }
 
+    double getTraversalThroughput() const {
+        return traversalTime > 0 ? (traversalCount / traversalTime) * 1000.0 : 0.0;
+    }
+
+    // traversed edges per second
+    double getTEPS() const {
+        return traversalTime > 0 ? (edgesTraversed / traversalTime) * 1000.0 : 0.0;
+    }
+
+    // latency at percentile p (0-100) in milliseconds, 0 without samples
+    double getInsertLatency(double p) const {
+        return insertLatency.percentile(p) / 1e6;
+    }
+
+    double getSearchLatency(double p) const {
+        return searchLatency.percentile(p) / 1e6;
+    }
+
+    double getDeleteLatency(double p) const {
+        return deleteLatency.percentile(p) / 1e6;
+    }
+
+    // hardware events over all phases
+    HardwareCounters getTotalCounters() const {
+        HardwareCounters total;
+        total += insertCounters;
+        total += searchCounters;
+        total += deleteCounters;
+        total += mixedCounters;
+        total += traversalCounters;
+        return total;
+    }
+
     // memory per element
     double getMemoryPerElement() const {
         return dataSize > 0 ? static_cast<double>(memoryUsed) / dataSize : 0.0;
@@ -81,6 +207,11 @@ public:
         string result = "\n" + structureName + " Performance Report:\n";
         result += "Dataset: " + to_string(dataSize) + " elements\n";
         result += "Total Time: " + to_string(totalTime) + " ms\n";
+        if (repetitions > 1) {
+            result += "Trials: " + to_string(repetitions) + " (median; stddev " +
+                      to_string(totalTimeStats.stddev) + " ms, 95% CI +/- " +
+                      to_string(totalTimeStats.ci95) + " ms)\n";
+        }
         result += "Memory: " + to_string(memoryUsed) + " bytes (" +
                   to_string(memoryUsed / 1024.0) + " KB)\n";
 
@@ -102,10 +233,48 @@ public:
                       to_string(getAverageDeleteTime()) + " ms/op)\n";
         }
 
+        result += latencyLine("Insert", insertLatency);
+        result += latencyLine("Search", searchLatency);
+        result += latencyLine("Delete", deleteLatency);
+
+        if (traversalCount > 0) {
+            result += "Traversal: " + to_string(traversalCount) + " vertices visited, " +
+                      to_string(traversalTime) + " ms (" +
+                      to_string(getTraversalThroughput()) + " vertices/s)\n";
+        }
+
+        if (edgesTraversed > 0) {
+            result += "TEPS: " + to_string(getTEPS()) + " edges/s\n";
+        }
+
         result += "Memory/element: " + to_string(getMemoryPerElement()) + " bytes\n";
+        result += countersLine("Insert", insertCounters);
+        result += countersLine("Search", searchCounters);
+        result += countersLine("Delete", deleteCounters);
+        result += countersLine("Mixed", mixedCounters);
+        result += countersLine("Traversal", traversalCounters);
+
+        if (allocationCount > 0) {
+            result += "Heap: peak " + to_string(peakMemory) + " bytes, " +
+                      to_string(allocationCount) + " allocations\n";
+        }
         return result;
     }
 
+    // column names matching toCSV, for every CSV writer
+    static string csvHeader() {
+        return "Structure,DataSize,InsertTime(ms),SearchTime(ms),DeleteTime(ms),"
+               "TotalTime(ms),MemoryUsed(bytes),MemoryPerElement(bytes),Score,"
+               "InsertCount,SearchCount,DeleteCount,"
+               "TraversalTime(ms),TraversalCount,EdgesTraversed,"
+               "InsertP50(ms),InsertP99(ms),InsertP999(ms),"
+               "SearchP50(ms),SearchP99(ms),SearchP999(ms),"
+               "DeleteP50(ms),DeleteP99(ms),DeleteP999(ms),"
+               "Repetitions,TotalTimeStdDev(ms),TotalTimeCI95(ms),"
+               "PeakMemory(bytes),Allocations,"
+               "Cycles,Instructions,L1DMisses,LLCMisses,BranchMisses";
+    }
+
     // export to CSV format
     string toCSV() const {
         std::stringstream ss;
@@ -118,9 +287,48 @@ public:
            << totalTime << ","
            << memoryUsed << ","
            << getMemoryPerElement() << ","
-           << score; // Export Score
+           << score << "," // Export Score
+           << insertCount << ","
+           << searchCount << ","
+           << deleteCount << ","
+           << traversalTime << ","
+           << traversalCount << ","
+           << edgesTraversed;
+        for (const LatencyHistogram* h : {&insertLatency, &searchLatency, &deleteLatency}) {
+            ss << "," << h->percentile(50) / 1e6
+               << "," << h->percentile(99) / 1e6
+               << "," << h->percentile(99.9) / 1e6;
+        }
+        ss << "," << repetitions
+           << "," << totalTimeStats.stddev
+           << "," << totalTimeStats.ci95
+           << "," << peakMemory
+           << "," << allocationCount;
+        HardwareCounters total = getTotalCounters();
+        ss << "," << total.cycles
+           << "," << total.instructions
+           << "," << total.l1dMisses
+           << "," << total.llcMisses
+           << "," << total.branchMisses;
         return ss.str();
     }
+
+private:
+    // "Search events: ..." line for toString, empty when not recorded
+    static string countersLine(const string& phase, const HardwareCounters& c) {
+        if (!c.recorded)
+            return "";
+        return phase + " events: " + c.toString() + "\n";
+    }
+
+    // "Search p50/p99/p99.9: ..." line for toString, empty without samples
+    static string latencyLine(const string& op, const LatencyHistogram& h) {
+        if (h.getCount() == 0)
+            return "";
+        return op + " p50/p99/p99.9: " + to_string(h.percentile(50) / 1e6) + " / " +
+               to_string(h.percentile(99) / 1e6) + " / " +
+               to_string(h.percentile(99.9) / 1e6) + " ms\n";
+    }
 };
 
 #endif
@@ -0,0 +1,67 @@
+#ifndef TRIALSTATS_H
+#define TRIALSTATS_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// summary of one metric over repeated benchmark trials: median (the value
+// reported), mean, sample standard deviation and the half-width of the 95%
+// confidence interval of the mean (Student's t, so small trial counts get
+// honestly wide intervals)
+struct TrialStats {
+    int samples;
+    double mean;
+    double median;
+    double stddev;
+    double ci95;
+
+    TrialStats() : samples(0), mean(0.0), median(0.0), stddev(0.0), ci95(0.0) {}
+
+    static TrialStats of(vector<double> values) {
+        TrialStats s;
+        s.samples = static_cast<int>(values.size());
+        if (s.samples == 0)
+            return s;
+
+        sort(values.begin(), values.end());
+        int mid = s.samples / 2;
+        s.median = s.samples % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+
+        for (double v : values) s.mean += v;
+        s.mean /= s.samples;
+
+        if (s.samples > 1) {
+            double squares = 0.0;
+            for (double v : values) squares += (v - s.mean) * (v - s.mean);
+            s.stddev = sqrt(squares / (s.samples - 1));
+            s.ci95 = tCritical(s.samples - 1) * s.stddev / sqrt(static_cast<double>(s.samples));
+        }
+        return s;
+    }
+
+    double lower() const { return mean - ci95; }
+    double upper() const { return mean + ci95; }
+
+    // true when both intervals exist and overlap: the difference between
+    // the two measurements is within run-to-run noise
+    bool overlaps(const TrialStats& other) const {
+        return samples > 1 && other.samples > 1 &&
+               lower() <= other.upper() && other.lower() <= upper();
+    }
+
+private:
+    // two-sided 95% critical value of Student's t for df degrees of freedom
+    static double tCritical(int df) {
+        static const double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+        };
+        return df <= 30 ? table[df - 1] : 1.960;
+    }
+};
+
+#endif
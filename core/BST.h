@@ -5,7 +5,10 @@
 #include <stdexcept>
 #include <vector>
 #include <cmath>
+#include <type_traits>
 #include <Queue.h>
+#include <PoolAllocator.h>
+#include <StaticSearchTree.h>
 
 using namespace std;
 
@@ -16,72 +19,175 @@ public:
     Node* left;
     Node* right;
     int height;
+    int size;    // nodes in this subtree (fits in the padding after height)
 
     Node(T val){
         data = val;
         left = nullptr;
         right = nullptr;
         height = 0;
+        size = 1;
     }
 };
 
-template <typename T>
+// balancing policies for BST
+// NoBalancing: plain BST, shape follows insertion order
+struct NoBalancing {
+    static constexpr bool selfBalancing = false;
+};
+
+// AVLBalancing: rotations keep |height(left) - height(right)| <= 1 everywhere
+struct AVLBalancing {
+    static constexpr bool selfBalancing = true;
+};
+
+template <typename T, typename Balance = NoBalancing,
+          template <typename> class Alloc = PoolAllocator>
 class BST {
     Node<T>* root;
     int nodeCount;
+    Alloc<Node<T>> pool;
+    vector<Node<T>**> path;  // scratch: links from root to the node being changed
 
-    Node<T>* insert(Node<T>* node, T val) {
-        if (!node) {
-            nodeCount++;
-            return new Node<T>(val);
-        }
-        if (val > node->data)
-            node->right = insert(node->right, val);
-        else
-            node->left = insert(node->left, val);
-
+    void updateHeight(Node<T>* node) {
         node->height = max(height(node->left), height(node->right)) + 1;
+        node->size = subtreeSize(node->left) + subtreeSize(node->right) + 1;
+    }
+
+    int subtreeSize(Node<T>* node) {
+        return node ? node->size : 0;
+    }
+
+    int balanceFactor(Node<T>* node) {
+        return height(node->left) - height(node->right);
+    }
+
+    Node<T>* rotateRight(Node<T>* node) {
+        Node<T>* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    Node<T>* rotateLeft(Node<T>* node) {
+        Node<T>* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    // restore the AVL invariant at node (children already balanced)
+    // returns the new root of this subtree
+    Node<T>* rebalance(Node<T>* node) {
+        updateHeight(node);
+        if constexpr (Balance::selfBalancing) {
+            int bf = balanceFactor(node);
+            if (bf > 1) {
+                if (balanceFactor(node->left) < 0)
+                    node->left = rotateLeft(node->left);     // left-right case
+                return rotateRight(node);
+            }
+            if (bf < -1) {
+                if (balanceFactor(node->right) > 0)
+                    node->right = rotateRight(node->right);  // right-left case
+                return rotateLeft(node);
+            }
+        }
         return node;
     }
 
-    Node<T>* search(Node<T>* node, T target) {
-        if(!node || node->data == target) return node;
-        if(target > node->data)
-            return search(node->right, target);
-        return search(node->left, target);
+    // walk back up a recorded root-to-node path, refreshing heights and
+    // rebalancing; once a subtree's shape and height are unchanged only the
+    // subtree sizes above it still need adjusting by delta
+    void retrace(int delta) {
+        int i = (int)path.size() - 1;
+        for (; i >= 0; i--) {
+            Node<T>** link = path[i];
+            Node<T>* node = *link;
+            int oldHeight = node->height;
+            Node<T>* subtree = rebalance(node);
+            *link = subtree;
+            if (subtree == node && node->height == oldHeight) break;
+        }
+        for (i--; i >= 0; i--)
+            (*path[i])->size += delta;
+        path.clear();
     }
 
-    Node<T>* remove(Node<T>* node, T val){
-        if (!node) return nullptr;
+    void insertNode(const T& val) {
+        Node<T>** link = &root;
+        while (*link) {
+            path.push_back(link);
+            link = (val > (*link)->data) ? &(*link)->right : &(*link)->left;
+        }
+        *link = pool.create(val);
+        nodeCount++;
+        retrace(+1);
+    }
 
-        if(val < node->data){
-            node->left = remove(node->left, val);
+    Node<T>* search(Node<T>* node, const T& target) {
+        while (node && !(node->data == target))
+            node = (target > node->data) ? node->right : node->left;
+        return node;
+    }
+
+    void removeNode(const T& val) {
+        Node<T>** link = &root;
+        while (*link) {
+            if (val < (*link)->data) {
+                path.push_back(link);
+                link = &(*link)->left;
+            }
+            else if (val > (*link)->data) {
+                path.push_back(link);
+                link = &(*link)->right;
+            }
+            else break;
         }
-        else if(val > node->data){
-            node->right = remove(node->right, val);
+        if (!*link) {
+            path.clear();
+            return;
         }
-        else {
-            if(!node->left && !node->right){
-                delete node;
-                nodeCount--;
-                return nullptr;
+
+        Node<T>* node = *link;
+        if (node->left && node->right) {
+            // take the in-order successor's value, then unlink the successor
+            path.push_back(link);
+            link = &node->right;
+            while ((*link)->left) {
+                path.push_back(link);
+                link = &(*link)->left;
             }
-            else if(!node->left || !node->right){
-                Node<T>* child = (node->left) ? node->left : node->right;
-                delete node;
-                nodeCount--;
-                return child;
+            node->data = (*link)->data;
+            node = *link;
+        }
+
+        *link = (node->left) ? node->left : node->right;
+        pool.destroy(node);
+        nodeCount--;
+        retrace(-1);
+    }
+
+    // O(n) teardown without a stack: rotate left children up until the
+    // current node has none, then free it and continue down the right spine
+    void freeTree(Node<T>* node) {
+        while (node) {
+            if (node->left) {
+                Node<T>* child = node->left;
+                node->left = child->right;
+                child->right = node;
+                node = child;
             }
             else {
-                Node<T>* successor = node->right;
-                while(successor->left) successor = successor->left;
-                node->data = successor->data;
-                node->right = remove(node->right, successor->data);
+                Node<T>* next = node->right;
+                pool.destroy(node);
+                node = next;
             }
         }
-
-        node->height = max(height(node->left), height(node->right)) + 1;
-        return node;
     }
 
     int height(Node<T>* node){
@@ -90,32 +196,86 @@ class BST {
     }
 
     bool isBalance(Node<T>* node){
-        if (!node) return true;
-        int leftHeight = height(node->left);
-        int rightHeight = height(node->right);
-        if(abs(leftHeight - rightHeight) > 1) return false;
-        return isBalance(node->left) && isBalance(node->right);
+        vector<Node<T>*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node<T>* curr = stack.back();
+            stack.pop_back();
+            if (abs(height(curr->left) - height(curr->right)) > 1) return false;
+            if (curr->left) stack.push_back(curr->left);
+            if (curr->right) stack.push_back(curr->right);
+        }
+        return true;
     }
 
     void inOrder(Node<T>* node, vector<T>& result) {
-        if (!node) return;
-        inOrder(node->left, result);
-        result.push_back(node->data);
-        inOrder(node->right, result);
+        vector<Node<T>*> stack;
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            result.push_back(node->data);
+            node = node->right;
+        }
     }
 
     void preOrder(Node<T>* node, vector<T>& result) {
-        if (!node) return;
-        result.push_back(node->data);
-        preOrder(node->left, result);
-        preOrder(node->right, result);
+        vector<Node<T>*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node<T>* curr = stack.back();
+            stack.pop_back();
+            result.push_back(curr->data);
+            if (curr->right) stack.push_back(curr->right);
+            if (curr->left) stack.push_back(curr->left);
+        }
     }
 
     void postOrder(Node<T>* node, vector<T>& result) {
-        if (!node) return;
-        postOrder(node->left, result);
-        postOrder(node->right, result);
-        result.push_back(node->data);
+        vector<Node<T>*> stack;
+        Node<T>* lastVisited = nullptr;
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            Node<T>* top = stack.back();
+            if (top->right && top->right != lastVisited) {
+                node = top->right;
+            }
+            else {
+                result.push_back(top->data);
+                lastVisited = top;
+                stack.pop_back();
+            }
+        }
+    }
+
+    // in-order visit of [minVal, maxVal], skipping subtrees outside the range
+    // equal keys may sit on either side after rotations, so bounds are inclusive
+    template <typename Func>
+    void rangeVisit(Node<T>* node, const T& minVal, const T& maxVal, Func& visit) {
+        vector<Node<T>*> stack;
+        while (node || !stack.empty()) {
+            while (node) {
+                if (node->data < minVal) {
+                    node = node->right;  // node and its left subtree are below the range
+                }
+                else {
+                    stack.push_back(node);
+                    node = node->left;
+                }
+            }
+            if (stack.empty()) return;
+            node = stack.back();
+            stack.pop_back();
+            if (maxVal < node->data) return;  // everything after this is larger
+            visit(node->data);
+            node = node->right;
+        }
     }
 
     void levelOrder(Node<T>* node, vector<T>& result) {
@@ -123,7 +283,7 @@ class BST {
         Queue<Node<T>*> q;
         q.enqueue(node);
         while(!q.isEmpty()){
-            Node<T>* curr = q.frontValue();
+            Node<T>* curr = q.front();
             q.dequeue();
             result.push_back(curr->data);
             if(curr->left) q.enqueue(curr->left);
@@ -138,11 +298,20 @@ public:
     }
 
     ~BST() {
-        while(root) remove(root->data);
+        clear();
+    }
+
+    void clear() {
+        if constexpr (!(Alloc<Node<T>>::releasesAll && is_trivially_destructible<T>::value)) {
+            freeTree(root);
+        }
+        pool.release();
+        root = nullptr;
+        nodeCount = 0;
     }
 
     void insert(T val) {
-        root = insert(root, val);
+        insertNode(val);
     }
 
     bool searchValue(T target){
@@ -150,7 +319,7 @@ public:
     }
 
     void remove(T val){
-        root = remove(root, val);
+        removeNode(val);
     }
 
     vector<T> inOrder() {
@@ -177,16 +346,57 @@ public:
         return result;
     }
 
+    // O(h + k): only subtrees overlapping [minVal, maxVal] are visited
     vector<T> rangeQuery(T minVal, T maxVal){
         vector<T> result;
-        vector<T> all = inOrder();
-        for(auto val : all){
-            if(val >= minVal && val <= maxVal)
-                result.push_back(val);
+        forEachInRange(minVal, maxVal, [&result](const T& val) {
+            result.push_back(val);
+        });
+        return result;
+    }
+
+    // streaming form of rangeQuery: calls visit(value) in sorted order
+    // without materialising a vector
+    template <typename Func>
+    void forEachInRange(const T& minVal, const T& maxVal, Func visit){
+        if (maxVal < minVal) return;
+        rangeVisit(root, minVal, maxVal, visit);
+    }
+
+    // number of keys strictly less than x, O(height)
+    int rank(const T& x) {
+        int result = 0;
+        Node<T>* node = root;
+        while (node) {
+            if (node->data < x) {
+                result += subtreeSize(node->left) + 1;
+                node = node->right;
+            }
+            else node = node->left;
         }
         return result;
     }
 
+    // k-th smallest key, 0-based (select(0) == findMin()), O(height)
+    T select(int k) {
+        if (k < 0 || k >= nodeCount) throw out_of_range("Rank out of range!");
+        Node<T>* node = root;
+        while (true) {
+            int leftSize = subtreeSize(node->left);
+            if (k < leftSize) node = node->left;
+            else if (k == leftSize) return node->data;
+            else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+
+    // snapshot the keys into a read-only, cache-friendly search index
+    StaticSearchTree<T> freeze() {
+        return StaticSearchTree<T>(inOrder());
+    }
+
     int height(){
         return height(root);
     }
@@ -195,13 +405,33 @@ public:
         return nodeCount;
     }
 
+    size_t getReservedBytes() const {
+        return pool.bytesReserved();
+    }
+
+    size_t getUsedBytes() const {
+        return pool.bytesUsed();
+    }
+
+    // AVL trees are balanced by construction, so only the root needs checking
     bool isBalance(){
+        if constexpr (Balance::selfBalancing)
+            return !root || abs(balanceFactor(root)) <= 1;
         return isBalance(root);
     }
 
     T sumOfNodes(Node<T>* node){
-        if(!node) return 0;
-        return sumOfNodes(node->left) + sumOfNodes(node->right) + node->data;
+        T sum = 0;
+        vector<Node<T>*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node<T>* curr = stack.back();
+            stack.pop_back();
+            sum = sum + curr->data;
+            if (curr->left) stack.push_back(curr->left);
+            if (curr->right) stack.push_back(curr->right);
+        }
+        return sum;
     }
 
     T sumOfNodes(){
@@ -0,0 +1,594 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "HashMap.h"
+#include "Heap.h"
+
+using namespace std;
+
+// Read-only graph in compressed sparse row form.
+// Vertices are interned to dense uint32 ids; the arcs leaving vertex v are
+// neighbors[offsets[v] .. offsets[v+1]) with matching weights, sorted by id.
+// Built in bulk from an edge list or frozen from a mutable Graph.
+template<typename T>
+class CSRGraph {
+public:
+    static constexpr uint32_t NoVertex = UINT32_MAX;
+
+    // Contiguous view of one vertex's neighbor ids and edge weights
+    class NeighborRange {
+    private:
+        const uint32_t* first;
+        const uint32_t* last;
+        const double* weightsBegin;
+
+    public:
+        NeighborRange(const uint32_t* f, const uint32_t* l, const double* w)
+            : first(f), last(l), weightsBegin(w) {}
+
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+        uint32_t operator[](size_t i) const { return first[i]; }
+        double weight(size_t i) const { return weightsBegin[i]; }
+    };
+
+private:
+    vector<T> vertices;               // id -> vertex
+    HashMap<T, uint32_t, FlatHashing> ids;  // vertex -> id
+    vector<uint32_t> offsets;         // size vertexCount + 1
+    vector<uint32_t> neighbors;       // arc targets, grouped by source
+    vector<double> weights;           // parallel to neighbors
+    bool isDirected;
+    int edgeCount;
+
+    struct Arc {
+        uint32_t source;
+        uint32_t destination;
+        double weight;
+    };
+
+    uint32_t intern(const T& vertex) {
+        if (const uint32_t* id = ids.search(vertex))
+            return *id;
+        uint32_t id = vertices.size();
+        vertices.push_back(vertex);
+        ids.insert(vertex, id);
+        return id;
+    }
+
+    // counting sort of arcs by source, then sort each row by target;
+    // parallel arcs between the same pair keep only the first
+    void build(const vector<Arc>& arcs) {
+        uint32_t n = vertices.size();
+        offsets.assign(n + 1, 0);
+        for (const Arc& a : arcs)
+            offsets[a.source + 1]++;
+        for (uint32_t v = 0; v < n; v++)
+            offsets[v + 1] += offsets[v];
+
+        vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        vector<pair<uint32_t, double>> row(arcs.size());
+        for (const Arc& a : arcs)
+            row[cursor[a.source]++] = make_pair(a.destination, a.weight);
+
+        neighbors.clear();
+        weights.clear();
+        neighbors.reserve(arcs.size());
+        weights.reserve(arcs.size());
+
+        uint32_t start = 0;
+        for (uint32_t v = 0; v < n; v++) {
+            uint32_t end = offsets[v + 1];
+            stable_sort(row.begin() + start, row.begin() + end,
+                        [](const pair<uint32_t, double>& a, const pair<uint32_t, double>& b) {
+                            return a.first < b.first;
+                        });
+            for (uint32_t i = start; i < end; i++) {
+                if (i > start && row[i].first == row[i - 1].first)
+                    continue;
+                neighbors.push_back(row[i].first);
+                weights.push_back(row[i].second);
+            }
+            offsets[v + 1] = neighbors.size();
+            start = end;
+        }
+        neighbors.shrink_to_fit();
+        weights.shrink_to_fit();
+    }
+
+public:
+    CSRGraph() : offsets(1, 0), isDirected(false), edgeCount(0) {}
+
+    // Bulk build from a weighted edge list (source, destination, weight)
+    CSRGraph(const vector<tuple<T, T, double>>& edges, bool directed = false)
+        : isDirected(directed), edgeCount(0) {
+        vector<Arc> arcs;
+        arcs.reserve(directed ? edges.size() : 2 * edges.size());
+        for (const auto& e : edges) {
+            uint32_t s = intern(get<0>(e));
+            uint32_t d = intern(get<1>(e));
+            arcs.push_back({s, d, get<2>(e)});
+            if (!directed && s != d)
+                arcs.push_back({d, s, get<2>(e)});
+        }
+        build(arcs);
+        countEdges();
+    }
+
+    // Bulk build from an unweighted edge list; every weight is 1
+    CSRGraph(const vector<pair<T, T>>& edges, bool directed = false)
+        : CSRGraph(withUnitWeights(edges), directed) {}
+
+    // Freeze a mutable graph (see Graph::toCSR); ids follow its vertex order.
+    // forEachEdge reports stored arcs, so undirected edges arrive in both
+    // directions already
+    template<typename MutableGraph>
+    explicit CSRGraph(const MutableGraph& graph)
+        : isDirected(graph.getIsDirected()), edgeCount(graph.getEdgeCount()) {
+        graph.forEachVertex([this](const T& v) { intern(v); });
+        vector<Arc> arcs;
+        arcs.reserve(isDirected ? edgeCount : 2 * edgeCount);
+        graph.forEachEdge([this, &arcs](const T& s, const T& d, double w) {
+            arcs.push_back({*ids.search(s), *ids.search(d), w});
+        });
+        build(arcs);
+    }
+
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    // id of a vertex, or NoVertex
+    uint32_t id(const T& vertex) const {
+        const uint32_t* found = ids.search(vertex);
+        return found ? *found : NoVertex;
+    }
+
+    // vertex for an id
+    const T& vertex(uint32_t id) const {
+        return vertices[id];
+    }
+
+    // neighbors of an id, O(1)
+    NeighborRange neighborsOf(uint32_t id) const {
+        return NeighborRange(neighbors.data() + offsets[id],
+                             neighbors.data() + offsets[id + 1],
+                             weights.data() + offsets[id]);
+    }
+
+    // neighbors of a vertex; empty if it does not exist
+    NeighborRange getNeighbors(const T& vertex) const {
+        uint32_t v = id(vertex);
+        if (v == NoVertex)
+            return NeighborRange(nullptr, nullptr, nullptr);
+        return neighborsOf(v);
+    }
+
+    uint32_t degree(uint32_t id) const {
+        return offsets[id + 1] - offsets[id];
+    }
+
+    // SEARCH: Check if a vertex exists in the graph
+    bool search(const T& vertex) const {
+        return id(vertex) != NoVertex;
+    }
+
+    // SEARCH: Check if an edge exists, binary search within the row
+    bool search(const T& source, const T& destination) const {
+        uint32_t s = id(source);
+        uint32_t d = id(destination);
+        if (s == NoVertex || d == NoVertex)
+            return false;
+        NeighborRange row = neighborsOf(s);
+        return binary_search(row.begin(), row.end(), d);
+    }
+
+    // Get the number of vertices
+    int getVertexCount() const {
+        return vertices.size();
+    }
+
+    // Get the number of edges (undirected edges count once)
+    int getEdgeCount() const {
+        return edgeCount;
+    }
+
+    // Number of stored arcs (twice the edges for undirected graphs)
+    size_t getArcCount() const {
+        return neighbors.size();
+    }
+
+    bool getIsDirected() const {
+        return isDirected;
+    }
+
+    bool isEmpty() const {
+        return vertices.empty();
+    }
+
+    // ---------------- traversals (visited sets are bitmaps over ids) ----------------
+
+    // Breadth-first order of the ids reachable from source
+    vector<uint32_t> bfs(uint32_t source) const {
+        vector<uint64_t> visited((vertices.size() + 63) / 64, 0);
+        vector<uint32_t> order;
+        order.push_back(source);
+        mark(visited, source);
+
+        // order doubles as the queue
+        for (size_t head = 0; head < order.size(); head++) {
+            for (uint32_t w : neighborsOf(order[head])) {
+                if (!isMarked(visited, w)) {
+                    mark(visited, w);
+                    order.push_back(w);
+                }
+            }
+        }
+        return order;
+    }
+
+    // Depth-first preorder of the ids reachable from source, iterative
+    vector<uint32_t> dfs(uint32_t source) const {
+        vector<uint64_t> visited((vertices.size() + 63) / 64, 0);
+        vector<uint32_t> order;
+        vector<pair<uint32_t, uint32_t>> stack;  // (vertex, next arc index)
+        order.push_back(source);
+        mark(visited, source);
+        stack.push_back(make_pair(source, offsets[source]));
+
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            if (top.second == offsets[top.first + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            uint32_t w = neighbors[top.second++];
+            if (!isMarked(visited, w)) {
+                mark(visited, w);
+                order.push_back(w);
+                stack.push_back(make_pair(w, offsets[w]));
+            }
+        }
+        return order;
+    }
+
+    // Dijkstra from source; unreachable ids get infinity
+    // lazy deletion: stale heap entries are skipped instead of decreased
+    vector<double> shortestPaths(uint32_t source) const {
+        const double inf = numeric_limits<double>::infinity();
+        vector<double> dist(vertices.size(), inf);
+        Heap<pair<double, uint32_t>, 4> frontier(true);
+        dist[source] = 0.0;
+        frontier.insert(make_pair(0.0, source));
+
+        while (!frontier.isEmpty()) {
+            pair<double, uint32_t> top = frontier.extractTop();
+            uint32_t u = top.second;
+            if (top.first > dist[u])
+                continue;
+
+            for (uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                if (weights[i] < 0)
+                    throw invalid_argument("Dijkstra requires non-negative edge weights");
+                double candidate = top.first + weights[i];
+                uint32_t w = neighbors[i];
+                if (candidate < dist[w]) {
+                    dist[w] = candidate;
+                    frontier.insert(make_pair(candidate, w));
+                }
+            }
+        }
+        return dist;
+    }
+
+    // Direction-optimizing BFS on `threads` threads; returns the BFS level
+    // of every id, NoVertex where unreachable.
+    // Top-down steps split the frontier queue across threads, which claim
+    // vertices with an atomic bit in the visited bitmap and collect them in
+    // per-thread queues. The threads are started once per call and kept for
+    // every level, and so are their queues. Bottom-up steps split the vertex
+    // range by bitmap word: each unvisited vertex scans its neighbors for one
+    // in the frontier bitmap and stops at the first hit. A step goes
+    // bottom-up once the frontier's arcs exceed 1/14 of the unexplored arcs,
+    // and back when the frontier drops under 1/24 of the vertices. Bottom-up
+    // needs incoming arcs, which only undirected graphs store, so directed
+    // graphs always run top-down.
+    vector<uint32_t> parallelBfs(uint32_t source, int threads) const {
+        static constexpr uint64_t Alpha = 14;
+        static constexpr uint64_t Beta = 24;
+
+        uint32_t n = vertices.size();
+        if (source >= n)
+            throw out_of_range("BFS source is not a vertex id");
+        size_t words = (size_t(n) + 63) / 64;
+        threads = max(1, threads);
+
+        vector<uint32_t> level(n, NoVertex);
+        unique_ptr<atomic<uint64_t>[]> visited(new atomic<uint64_t>[words]);
+        for (size_t w = 0; w < words; w++)
+            visited[w].store(0, memory_order_relaxed);
+        if (n % 64 != 0)  // bits past the last vertex count as visited
+            visited[n / 64].store(~uint64_t(0) << (n % 64), memory_order_relaxed);
+
+        vector<uint64_t> frontierBits(words, 0);
+        vector<uint64_t> nextBits(words, 0);
+        vector<uint32_t> frontier(1, source);
+        vector<vector<uint32_t>> localNext(threads);
+        vector<uint64_t> foundCount(threads), foundArcs(threads);
+
+        level[source] = 0;
+        visited[source >> 6].fetch_or(uint64_t(1) << (source & 63), memory_order_relaxed);
+        uint64_t frontierSize = 1;
+        uint64_t frontierArcs = degree(source);
+        uint64_t unexploredArcs = neighbors.size() - frontierArcs;
+        bool bottomUp = false;
+        StepPool pool(threads);  // after the state its steps touch, so it joins first
+
+        for (uint32_t depth = 1; frontierSize > 0; depth++) {
+            // pick the direction and convert the frontier if it changes
+            if (!bottomUp && !isDirected && frontierArcs > unexploredArcs / Alpha) {
+                bottomUp = true;
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (uint32_t v : frontier)
+                    frontierBits[v >> 6] |= uint64_t(1) << (v & 63);
+            } else if (bottomUp && frontierSize < n / Beta) {
+                bottomUp = false;
+                frontier.clear();
+                for (size_t w = 0; w < words; w++)
+                    for (uint64_t bits = frontierBits[w]; bits != 0; bits &= bits - 1)
+                        frontier.push_back(w * 64 + lowestBit(bits));
+            }
+
+            fill(foundCount.begin(), foundCount.end(), 0);
+            fill(foundArcs.begin(), foundArcs.end(), 0);
+
+            if (bottomUp) {
+                fill(nextBits.begin(), nextBits.end(), 0);
+                pool.run(words, [&](int t, size_t begin, size_t end) {
+                    for (size_t w = begin; w < end; w++) {
+                        uint64_t seen = visited[w].load(memory_order_relaxed);
+                        for (uint64_t todo = ~seen; todo != 0; todo &= todo - 1) {
+                            int bit = lowestBit(todo);
+                            uint32_t v = w * 64 + bit;
+                            for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+                                uint32_t u = neighbors[i];
+                                if ((frontierBits[u >> 6] >> (u & 63)) & 1) {
+                                    level[v] = depth;
+                                    seen |= uint64_t(1) << bit;
+                                    nextBits[w] |= uint64_t(1) << bit;
+                                    foundCount[t]++;
+                                    foundArcs[t] += degree(v);
+                                    break;
+                                }
+                            }
+                        }
+                        // this thread owns word w during the step
+                        visited[w].store(seen, memory_order_relaxed);
+                    }
+                });
+                frontierBits.swap(nextBits);
+            } else {
+                pool.run(frontier.size(), [&](int t, size_t begin, size_t end) {
+                    vector<uint32_t>& out = localNext[t];
+                    out.clear();
+                    for (size_t j = begin; j < end; j++) {
+                        for (uint32_t w : neighborsOf(frontier[j])) {
+                            uint64_t bit = uint64_t(1) << (w & 63);
+                            if (visited[w >> 6].load(memory_order_relaxed) & bit)
+                                continue;
+                            if (visited[w >> 6].fetch_or(bit, memory_order_relaxed) & bit)
+                                continue;  // another thread claimed it first
+                            level[w] = depth;
+                            out.push_back(w);
+                            foundArcs[t] += degree(w);
+                        }
+                    }
+                    foundCount[t] = out.size();
+                });
+                frontier.clear();
+                for (int t = 0; t < threads; t++)
+                    frontier.insert(frontier.end(), localNext[t].begin(), localNext[t].end());
+            }
+
+            frontierSize = 0;
+            frontierArcs = 0;
+            for (int t = 0; t < threads; t++) {
+                frontierSize += foundCount[t];
+                frontierArcs += foundArcs[t];
+            }
+            unexploredArcs -= min(unexploredArcs, frontierArcs);
+        }
+        return level;
+    }
+
+    // Connected components by union-find (weakly connected for directed
+    // graphs); component[id] is a label in [0, count)
+    int connectedComponents(vector<uint32_t>& component) const {
+        uint32_t n = vertices.size();
+        vector<uint32_t> parent(n);
+        vector<uint32_t> setSize(n, 1);
+        for (uint32_t v = 0; v < n; v++)
+            parent[v] = v;
+
+        for (uint32_t u = 0; u < n; u++) {
+            for (uint32_t w : neighborsOf(u)) {
+                uint32_t a = findRoot(parent, u);
+                uint32_t b = findRoot(parent, w);
+                if (a == b)
+                    continue;
+                if (setSize[a] < setSize[b])
+                    swap(a, b);
+                parent[b] = a;
+                setSize[a] += setSize[b];
+            }
+        }
+
+        component.assign(n, NoVertex);
+        vector<uint32_t> label(n, NoVertex);
+        int count = 0;
+        for (uint32_t v = 0; v < n; v++) {
+            uint32_t root = findRoot(parent, v);
+            if (label[root] == NoVertex)
+                label[root] = count++;
+            component[v] = label[root];
+        }
+        return count;
+    }
+
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + vertices.capacity() * sizeof(T) + ids.getReservedBytes() +
+               offsets.capacity() * sizeof(uint32_t) + neighbors.capacity() * sizeof(uint32_t) +
+               weights.capacity() * sizeof(double);
+    }
+
+private:
+    static void mark(vector<uint64_t>& bits, uint32_t v) {
+        bits[v >> 6] |= uint64_t(1) << (v & 63);
+    }
+
+    static bool isMarked(const vector<uint64_t>& bits, uint32_t v) {
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+
+    static int lowestBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int n = 0;
+        while (!(x & 1)) { x >>= 1; n++; }
+        return n;
+#endif
+    }
+
+    // threads - 1 workers kept for the length of one parallel BFS.
+    // run(count, body) calls body(thread, begin, end) over [0, count) split
+    // into equal chunks, one per thread, with the calling thread taking
+    // chunk 0, and returns when every chunk is done. Levels hand over
+    // through a generation counter, so no thread is started per level
+    class StepPool {
+    public:
+        explicit StepPool(int threads)
+            : threadCount(threads), count(0), chunk(0), body(nullptr), call(nullptr),
+              generation(0), pending(0), stopping(false) {
+            for (int t = 1; t < threads; t++)
+                workers.emplace_back([this, t]() { work(t); });
+        }
+
+        StepPool(const StepPool&) = delete;
+        StepPool& operator=(const StepPool&) = delete;
+
+        ~StepPool() {
+            {
+                lock_guard<mutex> lock(guard);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (thread& worker : workers)
+                worker.join();
+        }
+
+        template<typename Func>
+        void run(size_t total, Func&& step) {
+            if (threadCount == 1) {
+                step(0, 0, total);
+                return;
+            }
+            // published to the workers by the locked generation bump
+            count = total;
+            chunk = (total + threadCount - 1) / threadCount;
+            body = &step;
+            call = [](void* f, int t, size_t begin, size_t end) {
+                (*static_cast<remove_reference_t<Func>*>(f))(t, begin, end);
+            };
+            {
+                lock_guard<mutex> lock(guard);
+                pending = threadCount - 1;
+                generation++;
+            }
+            wake.notify_all();
+
+            step(0, 0, min(total, chunk));
+
+            unique_lock<mutex> lock(guard);
+            done.wait(lock, [this]() { return pending == 0; });
+        }
+
+    private:
+        int threadCount;
+        size_t count;
+        size_t chunk;
+        void* body;
+        void (*call)(void*, int, size_t, size_t);
+        vector<thread> workers;
+
+        mutex guard;
+        condition_variable wake;   // workers: a step is ready or the pool stops
+        condition_variable done;   // caller: the last worker finished its chunk
+        unsigned long generation;
+        int pending;
+        bool stopping;
+
+        void work(int t) {
+            unsigned long seen = 0;
+            unique_lock<mutex> lock(guard);
+            while (true) {
+                wake.wait(lock, [&]() { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+                size_t begin = min(count, t * chunk);
+                size_t end = min(count, begin + chunk);
+                lock.unlock();
+                call(body, t, begin, end);
+                lock.lock();
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }
+    };
+
+    // union-find root with path halving
+    static uint32_t findRoot(vector<uint32_t>& parent, uint32_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    static vector<tuple<T, T, double>> withUnitWeights(const vector<pair<T, T>>& edges) {
+        vector<tuple<T, T, double>> weighted;
+        weighted.reserve(edges.size());
+        for (const auto& e : edges)
+            weighted.emplace_back(e.first, e.second, 1.0);
+        return weighted;
+    }
+
+    // after deduplication: undirected edges are stored twice except loops
+    void countEdges() {
+        if (isDirected) {
+            edgeCount = neighbors.size();
+            return;
+        }
+        size_t loops = 0;
+        for (uint32_t v = 0; v < vertices.size(); v++)
+            loops += binary_search(neighbors.begin() + offsets[v], neighbors.begin() + offsets[v + 1], v);
+        edgeCount = (neighbors.size() - loops) / 2 + loops;
+    }
+};
+
+#endif // CSRGRAPH_H
@@ -0,0 +1,296 @@
+#ifndef CONCURRENTQUEUE_H
+#define CONCURRENTQUEUE_H
+
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// bounded lock-free queues for producer/consumer hand-off between threads
+// both keep the Queue vocabulary (enqueue/dequeue/front) but never block:
+// enqueue returns false when the ring is full, dequeue false when it is empty
+// capacities are rounded up to a power of two so indices wrap with a mask
+
+namespace concurrent_queue_detail {
+    // keep producer and consumer indices on separate cache lines
+    constexpr size_t CacheLine = 64;
+
+    inline size_t roundCapacity(size_t capacity) {
+        if (capacity == 0) {
+            throw invalid_argument("Queue capacity must be positive");
+        }
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        return rounded;
+    }
+}
+
+// single producer, single consumer ring (Lamport queue)
+// head is written only by the consumer and tail only by the producer, so
+// each side needs one release store per operation; each side also caches
+// the other's index and re-reads it only when the ring looks full/empty
+template <typename T>
+class SPSCQueue {
+private:
+    T* buffer;
+    size_t mask;
+
+    alignas(concurrent_queue_detail::CacheLine) atomic<size_t> head;  // next slot to read
+    size_t cachedTail;                                                // consumer's view of tail
+
+    alignas(concurrent_queue_detail::CacheLine) atomic<size_t> tail;  // next slot to write
+    size_t cachedHead;                                                // producer's view of head
+
+public:
+    // constructor
+    explicit SPSCQueue(size_t capacity = 1024)
+        : mask(concurrent_queue_detail::roundCapacity(capacity) - 1),
+          head(0), cachedTail(0), tail(0), cachedHead(0) {
+        buffer = static_cast<T*>(::operator new((mask + 1) * sizeof(T)));
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // destructor
+    ~SPSCQueue() {
+        size_t h = head.load(memory_order_relaxed);
+        size_t t = tail.load(memory_order_relaxed);
+        for (; h != t; h++) {
+            buffer[h & mask].~T();
+        }
+        ::operator delete(buffer);
+    }
+
+    // producer: add element at rear, false if full
+    bool enqueue(const T& val) {
+        return emplace(val);
+    }
+
+    bool enqueue(T&& val) {
+        return emplace(std::move(val));
+    }
+
+    // producer: construct element in place at rear, false if full
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(memory_order_acquire);
+            if (t - cachedHead > mask) {
+                return false;
+            }
+        }
+        new (buffer + (t & mask)) T(std::forward<Args>(args)...);
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // consumer: move front element into out, false if empty
+    bool dequeue(T& out) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (h == cachedTail) {
+                return false;
+            }
+        }
+        T* slot = buffer + (h & mask);
+        out = std::move(*slot);
+        slot->~T();
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    // consumer: drop front element, false if empty
+    bool dequeue() {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (h == cachedTail) {
+                return false;
+            }
+        }
+        buffer[h & mask].~T();
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    // consumer: get front element; stays valid until the consumer dequeues it
+    const T& front() {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (h == cachedTail) {
+                throw runtime_error("Queue is empty");
+            }
+        }
+        return buffer[h & mask];
+    }
+
+    // approximate while other threads are running
+    int size() const {
+        size_t t = tail.load(memory_order_acquire);
+        size_t h = head.load(memory_order_acquire);
+        return static_cast<int>(t - h);
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    size_t getCapacity() const {
+        return mask + 1;
+    }
+
+    // total footprint
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + getCapacity() * sizeof(T);
+    }
+};
+
+// multi-producer, multi-consumer bounded queue (Vyukov)
+// every cell carries a sequence number: seq == pos means the cell is free
+// for the producer that claims pos, seq == pos + 1 means it holds the value
+// for the consumer that claims pos. Threads claim positions with a CAS on
+// the shared index and then publish through the cell's sequence, so
+// producers and consumers only contend among themselves
+// there is no front(): another consumer may take the element as soon as it
+// is observed, so the only safe read is the one dequeue(out) performs
+template <typename T>
+class MPMCQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    Cell* cells;
+    size_t mask;
+
+    alignas(concurrent_queue_detail::CacheLine) atomic<size_t> enqueuePos;
+    alignas(concurrent_queue_detail::CacheLine) atomic<size_t> dequeuePos;
+
+    // claim the cell for the next position on the given side; nullptr when
+    // the queue is full (producers) or empty (consumers)
+    Cell* claim(atomic<size_t>& position, size_t ready, size_t& pos) {
+        pos = position.load(memory_order_relaxed);
+        while (true) {
+            Cell* cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + ready);
+            if (diff == 0) {
+                if (position.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    return cell;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = position.load(memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    // constructor
+    explicit MPMCQueue(size_t capacity = 1024)
+        : mask(concurrent_queue_detail::roundCapacity(capacity) - 1),
+          enqueuePos(0), dequeuePos(0) {
+        cells = new Cell[mask + 1];
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    // destructor
+    ~MPMCQueue() {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        size_t end = enqueuePos.load(memory_order_relaxed);
+        for (; pos != end; pos++) {
+            cells[pos & mask].value()->~T();
+        }
+        delete[] cells;
+    }
+
+    // add element at rear, false if full
+    bool enqueue(const T& val) {
+        return emplace(val);
+    }
+
+    bool enqueue(T&& val) {
+        return emplace(std::move(val));
+    }
+
+    // construct element in place at rear, false if full
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        size_t pos;
+        Cell* cell = claim(enqueuePos, 0, pos);
+        if (!cell) {
+            return false;
+        }
+        new (cell->value()) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    // move front element into out, false if empty
+    bool dequeue(T& out) {
+        size_t pos;
+        Cell* cell = claim(dequeuePos, 1, pos);
+        if (!cell) {
+            return false;
+        }
+        T* slot = cell->value();
+        out = std::move(*slot);
+        slot->~T();
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // drop front element, false if empty
+    bool dequeue() {
+        size_t pos;
+        Cell* cell = claim(dequeuePos, 1, pos);
+        if (!cell) {
+            return false;
+        }
+        cell->value()->~T();
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // approximate while other threads are running
+    int size() const {
+        size_t end = enqueuePos.load(memory_order_acquire);
+        size_t pos = dequeuePos.load(memory_order_acquire);
+        return end > pos ? static_cast<int>(end - pos) : 0;
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    size_t getCapacity() const {
+        return mask + 1;
+    }
+
+    // total footprint
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + getCapacity() * sizeof(Cell);
+    }
+};
+
+#endif
@@ -7,6 +7,10 @@
 #include <set>
 #include <queue>
 #include <stdexcept>
+#include <memory>
+#include <algorithm>
+#include "HashMap.h"
+#include "CSRGraph.h"
 
 using namespace std;
 
@@ -20,7 +24,94 @@ private:
         Edge(const T& dest, double w = 1.0) : destination(dest), weight(w) {}
     };
     
-    map<T, vector<Edge>> adjacencyList;
+    // Lists longer than this get a key -> position index
+    static constexpr size_t IndexThreshold = 16;
+    
+    // Edges of one vertex: unordered, removed by swap-and-pop.
+    // Short lists are scanned; once a list outgrows IndexThreshold it keeps
+    // a hash index from neighbor to position, so lookups stay O(1) for hubs.
+    template<typename E>
+    class IncidenceList {
+    private:
+        vector<E> items;
+        unique_ptr<HashMap<T, int, FlatHashing>> index;
+        
+        static const T& keyOf(const Edge& e) { return e.destination; }
+        static const T& keyOf(const T& vertex) { return vertex; }
+        
+        void buildIndex() {
+            index.reset(new HashMap<T, int, FlatHashing>(2 * items.size()));
+            for (size_t i = 0; i < items.size(); i++) {
+                index->insert(keyOf(items[i]), i);
+            }
+        }
+        
+    public:
+        // Position of the entry for key, or -1
+        int find(const T& key) const {
+            if (index) {
+                const int* pos = index->search(key);
+                return pos ? *pos : -1;
+            }
+            for (size_t i = 0; i < items.size(); i++) {
+                if (keyOf(items[i]) == key) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        void add(const E& item) {
+            items.push_back(item);
+            if (index) {
+                index->insert(keyOf(item), items.size() - 1);
+            } else if (items.size() > IndexThreshold) {
+                buildIndex();
+            }
+        }
+        
+        // Move the last entry into slot i, O(1)
+        void removeAt(int i) {
+            if (index) {
+                index->remove(keyOf(items[i]));
+            }
+            if (i != (int)items.size() - 1) {
+                items[i] = std::move(items.back());
+                if (index) {
+                    *index->search(keyOf(items[i])) = i;
+                }
+            }
+            items.pop_back();
+        }
+        
+        bool erase(const T& key) {
+            int i = find(key);
+            if (i < 0) {
+                return false;
+            }
+            removeAt(i);
+            return true;
+        }
+        
+        const vector<E>& entries() const {
+            return items;
+        }
+        
+        size_t size() const {
+            return items.size();
+        }
+        
+        size_t getMemoryUsage() const {
+            return items.capacity() * sizeof(E) + (index ? sizeof(*index) + index->getReservedBytes() : 0);
+        }
+    };
+    
+    struct Vertex {
+        IncidenceList<Edge> out;  // Outgoing edges (all edges when undirected)
+        IncidenceList<T> in;      // Sources of incoming edges, directed graphs only
+    };
+    
+    map<T, Vertex> adjacencyList;
     bool isDirected;
     int edgeCount;
 
@@ -33,68 +124,69 @@ public:
     
     // INSERT: Add a vertex to the graph
     void insert(const T& vertex) {
-        if (adjacencyList.find(vertex) == adjacencyList.end()) {
-            adjacencyList[vertex] = vector<Edge>();
-        }
+        adjacencyList[vertex];
     }
     
     // INSERT: Add an edge between two vertices
     void insert(const T& source, const T& destination, double weight = 1.0) {
         // Ensure both vertices exist
-        insert(source);
-        insert(destination);
+        Vertex& src = adjacencyList[source];
+        Vertex& dst = adjacencyList[destination];
         
-        // Check if edge already exists
-        for (const Edge& e : adjacencyList[source]) {
-            if (e.destination == destination) {
-                return;  // Edge already exists
-            }
+        // Check if edge already exists, O(1)
+        if (src.out.find(destination) >= 0) {
+            return;
         }
         
-        adjacencyList[source].push_back(Edge(destination, weight));
+        src.out.add(Edge(destination, weight));
         edgeCount++;
         
         if (!isDirected) {
-            adjacencyList[destination].push_back(Edge(source, weight));
+            if (source != destination) {
+                dst.out.add(Edge(source, weight));
+            }
+        } else {
+            dst.in.add(source);
         }
     }
     
     // DELETE: Remove a vertex and all its edges from the graph
+    // Only the incident edges are touched: O(degree)
     bool remove(const T& vertex) {
         auto it = adjacencyList.find(vertex);
         if (it == adjacencyList.end()) {
             return false;
         }
         
-        // Count edges being removed from this vertex
-        int edgesFromVertex = it->second.size();
-        
-        // Remove all edges TO this vertex from other vertices
-        for (auto& pair : adjacencyList) {
-            if (pair.first != vertex) {
-                auto& edges = pair.second;
-                int sizeBefore = edges.size();
-                edges.erase(
-                    remove_if(edges.begin(), edges.end(),
-                              [&vertex](const Edge& e) { return e.destination == vertex; }),
-                    edges.end()
-                );
-                int edgesRemoved = sizeBefore - edges.size();
-                if (isDirected) {
-                    edgeCount -= edgesRemoved;
-                }
+        Vertex& v = it->second;
+        
+        // Drop the back references held by every neighbor
+        for (const Edge& e : v.out.entries()) {
+            if (e.destination == vertex) {
+                continue;
+            }
+            Vertex& neighbor = adjacencyList.find(e.destination)->second;
+            if (isDirected) {
+                neighbor.in.erase(vertex);
+            } else {
+                neighbor.out.erase(vertex);
+            }
+        }
+        for (const T& source : v.in.entries()) {
+            if (source != vertex) {
+                adjacencyList.find(source)->second.out.erase(vertex);
             }
         }
         
-        // Update edge count for edges from this vertex
-        if (isDirected) {
-            edgeCount -= edgesFromVertex;
-        } else {
-            edgeCount -= edgesFromVertex;  // Already counted in removal from other vertices
+        // A self-loop shows up in both lists of a directed graph
+        int edgesRemoved = v.out.size() + v.in.size();
+        if (isDirected && v.out.find(vertex) >= 0) {
+            edgesRemoved--;
         }
+        edgeCount -= edgesRemoved;
         
         // Remove the vertex itself
-        adjacencyList.erase(vertex);
+        adjacencyList.erase(it);
         return true;
     }
     
@@ -105,30 +197,21 @@ public:
             return false;
         }
         
-        auto& edges = it->second;
-        int sizeBefore = edges.size();
-        edges.erase(
-            remove_if(edges.begin(), edges.end(),
-                      [&destination](const Edge& e) { return e.destination == destination; }),
-            edges.end()
-        );
-        
-        if (edges.size() == sizeBefore) {
+        if (!it->second.out.erase(destination)) {
             return false;  // Edge not found
         }
         
         edgeCount--;
         
-        if (!isDirected) {
-            auto destIt = adjacencyList.find(destination);
-            if (destIt != adjacencyList.end()) {
-                auto& destEdges = destIt->second;
-                destEdges.erase(
-                    remove_if(destEdges.begin(), destEdges.end(),
-                              [&source](const Edge& e) { return e.destination == source; }),
-                    destEdges.end()
-                );
+        if (source != destination) {
+            Vertex& dst = adjacencyList.find(destination)->second;
+            if (isDirected) {
+                dst.in.erase(source);
+            } else {
+                dst.out.erase(source);
             }
+        } else if (isDirected) {
+            it->second.in.erase(source);
         }
         
         return true;
@@ -146,13 +229,7 @@ public:
             return false;
         }
         
-        for (const Edge& e : it->second) {
-            if (e.destination == destination) {
-                return true;
-            }
-        }
-        
-        return false;
+        return it->second.out.find(destination) >= 0;
     }
     
     // Get all vertices in the graph
@@ -170,8 +247,8 @@ public:
         vector<T> neighbors;
         auto it = adjacencyList.find(vertex);
         if (it != adjacencyList.end()) {
-            neighbors.reserve(it->second.size());
-            for (const Edge& e : it->second) {
+            neighbors.reserve(it->second.out.size());
+            for (const Edge& e : it->second.out.entries()) {
                 neighbors.push_back(e.destination);
             }
         }
@@ -204,6 +281,94 @@ public:
         edgeCount = 0;
     }
     
+    // Visit every vertex in order
+    template<typename Func>
+    void forEachVertex(Func visit) const {
+        for (const auto& pair : adjacencyList) {
+            visit(pair.first);
+        }
+    }
+    
+    // Visit every stored edge as (source, destination, weight);
+    // undirected edges are visited once in each direction
+    template<typename Func>
+    void forEachEdge(Func visit) const {
+        for (const auto& pair : adjacencyList) {
+            for (const Edge& e : pair.second.out.entries()) {
+                visit(pair.first, e.destination, e.weight);
+            }
+        }
+    }
+    
+    // Estimated bytes: map nodes plus edge lists and their indices
+    size_t getMemoryUsage() const {
+        // red-black tree node: three pointers and a color next to the value
+        const size_t mapNodeOverhead = 4 * sizeof(void*);
+        size_t memory = sizeof(*this);
+        for (const auto& pair : adjacencyList) {
+            memory += mapNodeOverhead + sizeof(pair) +
+                      pair.second.out.getMemoryUsage() + pair.second.in.getMemoryUsage();
+        }
+        return memory;
+    }
+    
+    // Freeze into a compressed sparse row graph for fast traversal
+    CSRGraph<T> toCSR() const {
+        return CSRGraph<T>(*this);
+    }
+    
+    // The traversals below freeze the graph first (O(V+E)); to run several
+    // of them on an unchanged graph, call toCSR() once and use its methods
+    
+    // TRAVERSE: Breadth-first order from start
+    vector<T> bfs(const T& start) const {
+        return traverse(start, false);
+    }
+    
+    // TRAVERSE: Depth-first preorder from start
+    vector<T> dfs(const T& start) const {
+        return traverse(start, true);
+    }
+    
+    // TRAVERSE: Dijkstra distances from source to every reachable vertex
+    map<T, double> shortestPaths(const T& source) const {
+        map<T, double> result;
+        CSRGraph<T> csr = toCSR();
+        uint32_t s = csr.id(source);
+        if (s == CSRGraph<T>::NoVertex) {
+            return result;
+        }
+        vector<double> dist = csr.shortestPaths(s);
+        for (uint32_t v = 0; v < dist.size(); v++) {
+            if (dist[v] != numeric_limits<double>::infinity()) {
+                result[csr.vertex(v)] = dist[v];
+            }
+        }
+        return result;
+    }
+    
+    // TRAVERSE: Number of connected components (weak for directed graphs)
+    int countComponents() const {
+        vector<uint32_t> component;
+        return toCSR().connectedComponents(component);
+    }
+    
+private:
+    vector<T> traverse(const T& start, bool depthFirst) const {
+        vector<T> result;
+        CSRGraph<T> csr = toCSR();
+        uint32_t s = csr.id(start);
+        if (s == CSRGraph<T>::NoVertex) {
+            return result;
+        }
+        vector<uint32_t> order = depthFirst ? csr.dfs(s) : csr.bfs(s);
+        result.reserve(order.size());
+        for (uint32_t v : order) {
+            result.push_back(csr.vertex(v));
+        }
+        return result;
+    }
+    
 };
 
 #endif // GRAPH_H
\ No newline at end of file
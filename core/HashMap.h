@@ -7,13 +7,38 @@
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "PoolAllocator.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASHMAP_HAVE_SSE2 1
+#endif
+
+/**
+ * @brief Collision policy: separate chaining with one heap node per entry
+ */
+struct ChainedHashing {};
+
+/**
+ * @brief Collision policy: open addressing over a flat slot array, probed
+ * 16 slots at a time through a parallel array of control bytes
+ */
+struct FlatHashing {};
 
 /**
  * @brief HashMap implementation with separate chaining for collision resolution
  * @tparam K Key type (int, string, or any hashable type)
  * @tparam V Value type
+ * @tparam Policy Collision resolution policy (ChainedHashing or FlatHashing)
+ * @tparam Alloc Allocator for chain nodes (PoolAllocator or NewDeleteAllocator)
  */
-template<typename K, typename V>
+template<typename K, typename V, typename Policy = ChainedHashing,
+         template<typename> class Alloc = PoolAllocator>
 class HashMap {
 private:
     /**
@@ -32,15 +57,29 @@ private:
     int size;                 // Number of elements stored
     double maxLoadFactor;     // Threshold for rehashing (default 0.75)
 
+    // Incremental rehashing state. While oldBuckets is non-null, buckets
+    // [migrateIndex, oldCapacity) of the old table have not been moved yet.
+    // Old bucket i splits into new buckets i and i + oldCapacity, and the
+    // new array is left uninitialized: those two are nulled when i migrates,
+    // so new bucket j is valid only once j % oldCapacity < migrateIndex.
+    Node** oldBuckets;        // Previous bucket array during migration
+    int oldCapacity;          // Number of buckets in oldBuckets
+    int migrateIndex;         // Next old bucket to migrate
+    int migrationStep;        // Old buckets moved per operation (0 = rehash all at once)
+    int activeStep;           // Step for the current migration, at least migrationStep
+
+    Alloc<Node> nodePool;     // Storage for all chain nodes
+
     /**
      * @brief Hash function for different key types
      * @param key The key to hash
+     * @param cap Number of buckets in the target table
      * @return Bucket index
      */
-    int hash(const K& key) const {
+    int hash(const K& key, int cap) const {
         if constexpr (std::is_same_v<K, int>) {
             // Simple modulo hashing for integers
-            return std::abs(key) % capacity;
+            return std::abs(key) % cap;
         }
         else if constexpr (std::is_same_v<K, std::string>) {
             // DJB2 hash algorithm for strings
@@ -48,41 +87,131 @@ private:
             for (char c : key) {
                 hashValue = ((hashValue << 5) + hashValue) + c; // hash * 33 + c
             }
-            return hashValue % capacity;
+            return hashValue % cap;
         }
         else {
             // Use std::hash for other types
-            return std::hash<K>{}(key) % capacity;
+            return std::hash<K>{}(key) % cap;
+        }
+    }
+
+    int hash(const K& key) const {
+        return hash(key, capacity);
+    }
+
+    /**
+     * @brief Find the chain that currently owns a key
+     * @return Address of the chain head, in the old table if the key's old
+     * bucket has not been migrated yet, otherwise in the current table
+     */
+    Node** chainFor(const K& key) const {
+        if (oldBuckets != nullptr) {
+            int oldIndex = hash(key, oldCapacity);
+            if (oldIndex >= migrateIndex) {
+                return &oldBuckets[oldIndex];
+            }
+        }
+        return &buckets[hash(key)];
+    }
+
+    /**
+     * @brief Check whether a bucket of the current table may be read
+     * @return false for buckets still waiting on their old bucket's migration
+     */
+    bool bucketReady(int index) const {
+        return oldBuckets == nullptr || index % oldCapacity < migrateIndex;
+    }
+
+    /**
+     * @brief Move every node of an old chain into the current table
+     * Nodes are relinked, not reallocated, and keys are known to be unique,
+     * so no equality checks are needed.
+     */
+    void relinkChain(Node*& head) {
+        Node* current = head;
+        while (current != nullptr) {
+            Node* next = current->next;
+            int index = hash(current->key);
+            current->next = buckets[index];
+            buckets[index] = current;
+            current = next;
+        }
+        head = nullptr;
+    }
+
+    /**
+     * @brief Migrate up to count old buckets into the current table
+     * Frees the old bucket array once every bucket has been moved.
+     */
+    void migrate(int count) {
+        if (oldBuckets == nullptr) return;
+
+        while (count-- > 0 && migrateIndex < oldCapacity) {
+            // The chain's two destination buckets, nulled on first use
+            buckets[migrateIndex] = nullptr;
+            buckets[migrateIndex + oldCapacity] = nullptr;
+            relinkChain(oldBuckets[migrateIndex]);
+            migrateIndex++;
+        }
+
+        if (migrateIndex >= oldCapacity) {
+            delete[] oldBuckets;
+            oldBuckets = nullptr;
+            oldCapacity = 0;
+            migrateIndex = 0;
         }
     }
 
     /**
      * @brief Rehash the table when load factor exceeds threshold
-     * Time Complexity: O(n) where n is number of elements
+     * Existing nodes are relinked into a table twice the size. With a
+     * migration step of 0 every chain moves now; otherwise the old table is
+     * kept and drained a few buckets per operation. The step is raised so
+     * the migration always ends before the next resize is due, and the new
+     * array is zeroed piecewise by migrate(), so no single operation pays
+     * for the whole table.
+     * Time Complexity: O(n) immediate, O(step) per operation incremental
      */
     void rehash() {
-        int oldCapacity = capacity;
-        Node** oldBuckets = buckets;
+        // Only one migration in flight: finish the previous one first
+        // (a no-op unless the step was changed mid-migration)
+        migrate(oldCapacity);
+
+        oldBuckets = buckets;
+        oldCapacity = capacity;
+        migrateIndex = 0;
 
-        // Double the capacity
+        // Double the capacity; buckets are nulled as they are migrated into
         capacity *= 2;
-        buckets = new Node*[capacity]();  // Initialize all to nullptr
-        size = 0;  // Reset size, will be recounted during reinsertion
+        buckets = new Node*[capacity];
 
-        // Reinsert all elements into new table
-        for (int i = 0; i < oldCapacity; i++) {
-            Node* current = oldBuckets[i];
+        if (migrationStep <= 0) {
+            migrate(oldCapacity);
+            return;
+        }
+
+        // Every operation migrates, but only inserts bring the next resize
+        // closer, so spread the old table over the inserts left until then
+        int headroom = std::max(1, static_cast<int>(std::ceil(maxLoadFactor * capacity)) - size);
+        activeStep = std::max(migrationStep, (oldCapacity + headroom - 1) / headroom);
+    }
+
+    void freeChains(Node** table, int count) {
+        // The pool reclaims trivially destructible nodes wholesale in clear()
+        if constexpr (Alloc<Node>::releasesAll && std::is_trivially_destructible_v<Node>) {
+            std::fill(table, table + count, nullptr);
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            Node* current = table[i];
             while (current != nullptr) {
-                insert(current->key, current->value);  // Reinsert
                 Node* temp = current;
                 current = current->next;
-                delete temp;  // Free old node
+                nodePool.destroy(temp);
             }
+            table[i] = nullptr;
         }
-
-        delete[] oldBuckets;  // Free old bucket array
-
-
     }
 
 public:
@@ -90,9 +219,13 @@ public:
      * @brief Constructor
      * @param initialCapacity Initial number of buckets (default 16)
      * @param loadFactor Maximum load factor before rehashing (default 0.75)
+     * @param rehashStep Old buckets migrated per operation after a resize;
+     *        0 (default) rehashes the whole table at once
      */
-    HashMap(int initialCapacity = 16, double loadFactor = 0.75)
-        : capacity(initialCapacity), size(0), maxLoadFactor(loadFactor) {
+    HashMap(int initialCapacity = 16, double loadFactor = 0.75, int rehashStep = 0)
+        : capacity(initialCapacity), size(0), maxLoadFactor(loadFactor),
+        oldBuckets(nullptr), oldCapacity(0), migrateIndex(0), migrationStep(rehashStep),
+        activeStep(rehashStep) {
         buckets = new Node*[capacity]();  // Initialize all pointers to nullptr
     }
 
@@ -113,13 +246,15 @@ public:
      * Space Complexity: O(1)
      */
     void insert(const K& key, const V& value) {
+        migrate(activeStep);
+
         // Check if rehashing is needed
         if (getLoadFactor() >= maxLoadFactor) {
             rehash();
         }
 
-        int index = hash(key);
-        Node* current = buckets[index];
+        Node** head = chainFor(key);
+        Node* current = *head;
 
         // Check if key already exists (update value)
         while (current != nullptr) {
@@ -131,9 +266,9 @@ public:
         }
 
         // Key doesn't exist, insert new node at head of chain
-        Node* newNode = new Node(key, value);
-        newNode->next = buckets[index];
-        buckets[index] = newNode;
+        Node* newNode = nodePool.create(key, value);
+        newNode->next = *head;
+        *head = newNode;
         size++;
     }
 
@@ -145,8 +280,9 @@ public:
      * Time Complexity: O(1) average, O(n) worst case
      */
     V* search(const K& key) {
-        int index = hash(key);
-        Node* current = buckets[index];
+        migrate(activeStep);
+
+        Node* current = *chainFor(key);
 
         // Traverse the chain at this bucket
         while (current != nullptr) {
@@ -165,8 +301,7 @@ public:
      * @return true if key exists, false otherwise
      */
     bool contains(const K& key) const {
-        int index = hash(key);
-        Node* current = buckets[index];
+        Node* current = *chainFor(key);
 
         while (current != nullptr) {
             if (current->key == key) {
@@ -186,8 +321,10 @@ public:
      * Time Complexity: O(1) average, O(n) worst case
      */
     bool remove(const K& key) {
-        int index = hash(key);
-        Node* current = buckets[index];
+        migrate(activeStep);
+
+        Node** head = chainFor(key);
+        Node* current = *head;
         Node* prev = nullptr;
 
         while (current != nullptr) {
@@ -195,12 +332,12 @@ public:
                 // Found the key, remove it
                 if (prev == nullptr) {
                     // Removing first node in chain
-                    buckets[index] = current->next;
+                    *head = current->next;
                 } else {
                     // Removing middle or end node
                     prev->next = current->next;
                 }
-                delete current;
+                nodePool.destroy(current);
                 size--;
                 return true;
             }
@@ -216,18 +353,42 @@ public:
      * Time Complexity: O(n)
      */
     void clear() {
-        for (int i = 0; i < capacity; i++) {
-            Node* current = buckets[i];
-            while (current != nullptr) {
-                Node* temp = current;
-                current = current->next;
-                delete temp;
-            }
-            buckets[i] = nullptr;
+        if (oldBuckets != nullptr) {
+            freeChains(oldBuckets, oldCapacity);
+            delete[] oldBuckets;
+            // Null the new buckets no migration has reached yet
+            std::fill(buckets + migrateIndex, buckets + oldCapacity, nullptr);
+            std::fill(buckets + oldCapacity + migrateIndex, buckets + capacity, nullptr);
+            oldBuckets = nullptr;
+            oldCapacity = 0;
+            migrateIndex = 0;
         }
+        freeChains(buckets, capacity);
+        nodePool.release();
         size = 0;
     }
 
+    /**
+     * @brief Set how many old buckets each operation migrates after a resize
+     * @param step Buckets per operation; 0 rehashes the whole table at once
+     */
+    void setRehashStep(int step) {
+        migrationStep = step;
+        // A running migration keeps the step that ends it before the next resize
+        activeStep = isRehashing() ? std::max(activeStep, step) : step;
+        if (migrationStep <= 0) {
+            migrate(oldCapacity);
+        }
+    }
+
+    /**
+     * @brief Check whether an incremental rehash is in progress
+     * @return true while the old bucket array still holds entries
+     */
+    bool isRehashing() const {
+        return oldBuckets != nullptr;
+    }
+
     /**
      * @brief Get the number of elements in the map
      * @return Number of key-value pairs
@@ -267,10 +428,25 @@ public:
     size_t getMemoryUsage() const {
         size_t memory = sizeof(*this);              // Object overhead
         memory += capacity * sizeof(Node*);         // Bucket array
-        memory += size * sizeof(Node);              // All nodes
+        memory += oldCapacity * sizeof(Node*);      // Old bucket array while migrating
+        memory += nodePool.bytesReserved();         // Node slabs
         return memory;
     }
 
+    /**
+     * @brief Bytes reserved by the node allocator
+     */
+    size_t getReservedBytes() const {
+        return nodePool.bytesReserved();
+    }
+
+    /**
+     * @brief Bytes occupied by live nodes
+     */
+    size_t getUsedBytes() const {
+        return nodePool.bytesUsed();
+    }
+
 
 
 
@@ -283,6 +459,7 @@ public:
         keys.reserve(size);
 
         for (int i = 0; i < capacity; i++) {
+            if (!bucketReady(i)) continue;
             Node* current = buckets[i];
             while (current != nullptr) {
                 keys.push_back(current->key);
@@ -290,6 +467,14 @@ public:
             }
         }
 
+        for (int i = migrateIndex; i < oldCapacity; i++) {
+            Node* current = oldBuckets[i];
+            while (current != nullptr) {
+                keys.push_back(current->key);
+                current = current->next;
+            }
+        }
+
         return keys;
     }
 
@@ -302,18 +487,26 @@ public:
         int usedBuckets = 0;
         int totalChainLength = 0;
 
-        for (int i = 0; i < capacity; i++) {
-            if (buckets[i] != nullptr) {
-                usedBuckets++;
-                int chainLength = 0;
-                Node* current = buckets[i];
-                while (current != nullptr) {
-                    chainLength++;
-                    current = current->next;
+        auto scan = [&](Node* const* table, int from, int to) {
+            for (int i = from; i < to; i++) {
+                if (table == buckets && !bucketReady(i)) continue;
+                if (table[i] != nullptr) {
+                    usedBuckets++;
+                    int chainLength = 0;
+                    Node* current = table[i];
+                    while (current != nullptr) {
+                        chainLength++;
+                        current = current->next;
+                    }
+                    totalChainLength += chainLength;
+                    maxChainLength = std::max(maxChainLength, chainLength);
                 }
-                totalChainLength += chainLength;
-                maxChainLength = std::max(maxChainLength, chainLength);
             }
+        };
+
+        scan(buckets, 0, capacity);
+        if (oldBuckets != nullptr) {
+            scan(oldBuckets, migrateIndex, oldCapacity);
         }
 
         double avgChainLength = usedBuckets > 0 ?
@@ -323,4 +516,463 @@ public:
     }
 };
 
+/**
+ * @brief Open-addressing HashMap (SwissTable-style layout)
+ *
+ * Entries live in a flat slot array. A parallel array of one-byte control
+ * words records, for every slot, whether it is empty, deleted, or full; full
+ * slots keep the low 7 bits of the key's hash. A lookup loads a group of 16
+ * control bytes, compares all of them against those 7 bits at once (SSE2 when
+ * available), and only touches slots whose byte matched, so most probes cost
+ * one cache line of metadata plus one slot.
+ *
+ * @tparam K Key type (int, string, or any hashable type)
+ * @tparam V Value type
+ * @tparam Alloc Unused: slots live inline in the table
+ */
+template<typename K, typename V, template<typename> class Alloc>
+class HashMap<K, V, FlatHashing, Alloc> {
+private:
+    /**
+     * @brief Key-value storage for one slot
+     */
+    struct Slot {
+        K key;
+        V value;
+
+        Slot(const K& k, const V& v) : key(k), value(v) {}
+    };
+
+    static constexpr int GroupWidth = 16;
+    static constexpr int8_t CtrlEmpty = -128;     // 0b10000000
+    static constexpr int8_t CtrlDeleted = -2;     // 0b11111110, tombstone
+
+    /**
+     * @brief View of 16 consecutive control bytes
+     * Each match function returns a bitmask with bit i set when byte i matches.
+     */
+    struct Group {
+#ifdef HASHMAP_HAVE_SSE2
+        __m128i ctrl;
+
+        explicit Group(const int8_t* pos)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        uint32_t match(int8_t h2) const {
+            return static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+        }
+
+        uint32_t matchEmpty() const {
+            return match(CtrlEmpty);
+        }
+
+        // empty and deleted are the only bytes with the sign bit set
+        uint32_t matchEmptyOrDeleted() const {
+            return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+        }
+#else
+        const int8_t* ctrl;
+
+        explicit Group(const int8_t* pos) : ctrl(pos) {}
+
+        uint32_t match(int8_t h2) const {
+            uint32_t mask = 0;
+            for (int i = 0; i < GroupWidth; i++) {
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+
+        uint32_t matchEmpty() const {
+            return match(CtrlEmpty);
+        }
+
+        uint32_t matchEmptyOrDeleted() const {
+            uint32_t mask = 0;
+            for (int i = 0; i < GroupWidth; i++) {
+                mask |= static_cast<uint32_t>(ctrl[i] < 0) << i;
+            }
+            return mask;
+        }
+#endif
+    };
+
+    int8_t* ctrl;             // Control bytes, one per slot
+    Slot* slots;              // Uninitialised storage; only full slots hold objects
+    int capacity;             // Number of slots (power of two, multiple of 16)
+    int size;                 // Number of elements stored
+    int tombstones;           // Number of deleted markers
+    double maxLoadFactor;     // Threshold for growth (default 0.875)
+
+    /**
+     * @brief Full-width hash of a key, mixed so that both the high bits
+     * (group selection) and the low 7 bits (control byte) are well spread
+     */
+    static size_t hashKey(const K& key) {
+        uint64_t h;
+        if constexpr (std::is_same_v<K, std::string>) {
+            // DJB2 hash algorithm for strings, as in the chained map
+            h = 5381;
+            for (char c : key) {
+                h = ((h << 5) + h) + c;
+            }
+        } else {
+            h = static_cast<uint64_t>(std::hash<K>{}(key));
+        }
+        // 64-bit finaliser (MurmurHash3 fmix64)
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    static size_t h1(size_t hash) { return hash >> 7; }
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    static int lowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#else
+        int i = 0;
+        while (!(mask & 1u)) { mask >>= 1; i++; }
+        return i;
+#endif
+    }
+
+    int groupCount() const {
+        return capacity / GroupWidth;
+    }
+
+    /**
+     * @brief Locate the slot holding key
+     * @return Slot index, or -1 if the key is absent
+     *
+     * Groups are visited in triangular order (g, g+1, g+3, ...), which covers
+     * every group exactly once because the group count is a power of two.
+     */
+    int findIndex(const K& key) const {
+        size_t hash = hashKey(key);
+        int8_t tag = h2(hash);
+        size_t mask = groupCount() - 1;
+        size_t g = h1(hash) & mask;
+
+        for (int probe = 0; probe < groupCount(); probe++) {
+            int base = static_cast<int>(g) * GroupWidth;
+            Group group(ctrl + base);
+
+            for (uint32_t m = group.match(tag); m != 0; m &= m - 1) {
+                int idx = base + lowestBit(m);
+                if (slots[idx].key == key) {
+                    return idx;
+                }
+            }
+
+            // An empty byte means the key was never pushed past this group
+            if (group.matchEmpty() != 0) {
+                return -1;
+            }
+            g = (g + probe + 1) & mask;
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief First empty or deleted slot on the probe sequence of hash
+     */
+    int findInsertSlot(size_t hash) const {
+        size_t mask = groupCount() - 1;
+        size_t g = h1(hash) & mask;
+
+        for (int probe = 0; probe < groupCount(); probe++) {
+            int base = static_cast<int>(g) * GroupWidth;
+            uint32_t m = Group(ctrl + base).matchEmptyOrDeleted();
+            if (m != 0) {
+                return base + lowestBit(m);
+            }
+            g = (g + probe + 1) & mask;
+        }
+
+        throw std::runtime_error("HashMap is full");
+    }
+
+    static int roundCapacity(int requested) {
+        int cap = GroupWidth;
+        while (cap < requested) {
+            cap *= 2;
+        }
+        return cap;
+    }
+
+    void allocate(int newCapacity) {
+        capacity = newCapacity;
+        ctrl = new int8_t[capacity];
+        std::fill(ctrl, ctrl + capacity, CtrlEmpty);
+        slots = static_cast<Slot*>(::operator new(sizeof(Slot) * capacity));
+        tombstones = 0;
+    }
+
+    void destroySlots() {
+        for (int i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) {
+                slots[i].~Slot();
+            }
+        }
+    }
+
+    /**
+     * @brief Move every entry into a table of newCapacity slots
+     * Also drops all tombstones.
+     * Time Complexity: O(n)
+     */
+    void rehash(int newCapacity) {
+        int8_t* oldCtrl = ctrl;
+        Slot* oldSlots = slots;
+        int oldCapacity = capacity;
+
+        allocate(newCapacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] >= 0) {
+                // Keys are known to be distinct: no equality checks needed
+                size_t hash = hashKey(oldSlots[i].key);
+                int idx = findInsertSlot(hash);
+                ctrl[idx] = h2(hash);
+                new (&slots[idx]) Slot(std::move(oldSlots[i]));
+                oldSlots[i].~Slot();
+            }
+        }
+
+        delete[] oldCtrl;
+        ::operator delete(oldSlots);
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param initialCapacity Initial number of slots, rounded up to a power of two (minimum 16)
+     * @param loadFactor Maximum fraction of occupied slots, tombstones included (default 0.875)
+     */
+    HashMap(int initialCapacity = 16, double loadFactor = 0.875)
+        : ctrl(nullptr), slots(nullptr), capacity(0), size(0),
+        tombstones(0), maxLoadFactor(loadFactor) {
+        if (loadFactor <= 0.0 || loadFactor >= 1.0)
+            throw std::invalid_argument("Load factor must be in (0, 1) for open addressing");
+        allocate(roundCapacity(initialCapacity));
+    }
+
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+
+    /**
+     * @brief Destructor - frees all allocated memory
+     */
+    ~HashMap() {
+        destroySlots();
+        delete[] ctrl;
+        ::operator delete(slots);
+    }
+
+    /**
+     * @brief Insert or update a key-value pair
+     * @param key The key to insert
+     * @param value The value to associate with the key
+     *
+     * Time Complexity: O(1) average
+     */
+    void insert(const K& key, const V& value) {
+        int existing = findIndex(key);
+        if (existing >= 0) {
+            slots[existing].value = value;  // Update existing value
+            return;
+        }
+
+        // Tombstones lengthen probes just like live entries, so count both
+        if (size + tombstones + 1 > capacity * maxLoadFactor) {
+            // Mostly tombstones: clean up in place instead of growing
+            bool grow = (size + 1) > capacity * maxLoadFactor / 2;
+            rehash(grow ? capacity * 2 : capacity);
+        }
+
+        size_t hash = hashKey(key);
+        int idx = findInsertSlot(hash);
+        if (ctrl[idx] == CtrlDeleted) {
+            tombstones--;
+        }
+        ctrl[idx] = h2(hash);
+        new (&slots[idx]) Slot(key, value);
+        size++;
+    }
+
+    /**
+     * @brief Search for a value by key
+     * @param key The key to search for
+     * @return Pointer to value if found, nullptr otherwise
+     *
+     * Time Complexity: O(1) average
+     */
+    V* search(const K& key) {
+        int idx = findIndex(key);
+        return idx >= 0 ? &(slots[idx].value) : nullptr;
+    }
+
+    const V* search(const K& key) const {
+        int idx = findIndex(key);
+        return idx >= 0 ? &(slots[idx].value) : nullptr;
+    }
+
+    /**
+     * @brief Check if a key exists in the map
+     * @param key The key to check
+     * @return true if key exists, false otherwise
+     */
+    bool contains(const K& key) const {
+        return findIndex(key) >= 0;
+    }
+
+    /**
+     * @brief Remove a key-value pair
+     * @param key The key to remove
+     * @return true if key was found and removed, false otherwise
+     *
+     * Time Complexity: O(1) average
+     */
+    bool remove(const K& key) {
+        int idx = findIndex(key);
+        if (idx < 0) {
+            return false;  // Key not found
+        }
+
+        slots[idx].~Slot();
+        size--;
+
+        // If the group still has an empty byte, no probe ever continued past
+        // it, so the slot can go straight back to empty
+        int base = idx - (idx % GroupWidth);
+        if (Group(ctrl + base).matchEmpty() != 0) {
+            ctrl[idx] = CtrlEmpty;
+        } else {
+            ctrl[idx] = CtrlDeleted;
+            tombstones++;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove all elements from the map
+     * Time Complexity: O(capacity)
+     */
+    void clear() {
+        destroySlots();
+        std::fill(ctrl, ctrl + capacity, CtrlEmpty);
+        size = 0;
+        tombstones = 0;
+    }
+
+    /**
+     * @brief Get the number of elements in the map
+     * @return Number of key-value pairs
+     */
+    int getSize() const {
+        return size;
+    }
+
+    /**
+     * @brief Get the number of slots
+     * @return Current capacity
+     */
+    int getCapacity() const {
+        return capacity;
+    }
+
+    /**
+     * @brief Calculate current load factor
+     * @return Load factor (size / capacity)
+     */
+    double getLoadFactor() const {
+        return static_cast<double>(size) / capacity;
+    }
+
+    /**
+     * @brief Check if map is empty
+     * @return true if no elements, false otherwise
+     */
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    /**
+     * @brief Estimate memory usage in bytes
+     * @return Approximate memory consumption
+     */
+    size_t getMemoryUsage() const {
+        size_t memory = sizeof(*this);              // Object overhead
+        memory += capacity * sizeof(int8_t);        // Control bytes
+        memory += capacity * sizeof(Slot);          // Slot array
+        return memory;
+    }
+
+    /**
+     * @brief Bytes reserved for control bytes and slots
+     */
+    size_t getReservedBytes() const {
+        return capacity * (sizeof(int8_t) + sizeof(Slot));
+    }
+
+    /**
+     * @brief Bytes occupied by live entries
+     */
+    size_t getUsedBytes() const {
+        return size * sizeof(Slot);
+    }
+
+    /**
+     * @brief Get all keys in the map
+     * @return Vector of all keys
+     */
+    std::vector<K> getKeys() const {
+        std::vector<K> keys;
+        keys.reserve(size);
+
+        for (int i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) {
+                keys.push_back(slots[i].key);
+            }
+        }
+
+        return keys;
+    }
+
+    /**
+     * @brief Get probe statistics for benchmarking
+     * @return Pair of (max_groups_probed, average_groups_probed) over all keys
+     */
+    std::pair<int, double> getCollisionStats() const {
+        int maxProbe = 0;
+        long long totalProbe = 0;
+        size_t mask = groupCount() - 1;
+
+        for (int i = 0; i < capacity; i++) {
+            if (ctrl[i] < 0) {
+                continue;
+            }
+            size_t g = h1(hashKey(slots[i].key)) & mask;
+            size_t home = i / GroupWidth;
+            int probes = 1;
+            while (g != home) {
+                g = (g + probes) & mask;
+                probes++;
+            }
+            totalProbe += probes;
+            maxProbe = std::max(maxProbe, probes);
+        }
+
+        double avgProbe = size > 0 ? static_cast<double>(totalProbe) / size : 0.0;
+        return {maxProbe, avgProbe};
+    }
+};
+
 #endif // HASHMAP_H
@@ -6,12 +6,26 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
+
+// SSE4.1 child selection is compiled for x86 GCC/Clang whatever -m flags the
+// build uses, and picked at run time when the CPU supports it
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <smmintrin.h>
+#define HEAP_HAVE_SSE41 1
+#define HEAP_TARGET_SSE41 __attribute__((target("sse4.1")))
+#endif
 
 using namespace std;
 
-template <typename T>
+// d-ary heap; Arity children per node (2 = classic binary heap)
+// with Arity 4 or 8 the children of a node share one cache line for small T,
+// so heapifyDown touches fewer lines per level on large heaps
+template <typename T, int Arity = 2>
 class Heap {
 private:
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
     vector<T> data;
     bool isMinHeap;  // true = min-heap, false = max-heap
 
@@ -21,40 +35,119 @@ private:
     }
 
     // helper functions for indices
-    int parent(int i) const { return (i - 1) / 2; }
-    int leftChild(int i) const { return 2 * i + 1; }
-    int rightChild(int i) const { return 2 * i + 2; }
+    int parent(int i) const { return (i - 1) / Arity; }
+    int firstChild(int i) const { return Arity * i + 1; }
+
+    // index of the best child in [first, last); the scan selects with a
+    // conditional move instead of a branch per child
+    int bestChild(int first, int last) const {
+#ifdef HEAP_HAVE_SSE41
+        if constexpr (simdLanes) {
+            if (last - first == Arity && sse41Available()) {
+                int best = bestChildSimd(first);
+                if (best >= 0)
+                    return best;
+            }
+        }
+#endif
+        // heap direction is hoisted out of the loop so each step is one compare
+        int best = first;
+        if (isMinHeap) {
+            for (int c = first + 1; c < last; c++)
+                best = (data[c] < data[best]) ? c : best;
+        } else {
+            for (int c = first + 1; c < last; c++)
+                best = (data[c] > data[best]) ? c : best;
+        }
+        return best;
+    }
+
+#ifdef HEAP_HAVE_SSE41
+    // 32-bit lane types with an SSE4.1 min/max; other T use the scalar scan
+    static constexpr bool simdLanes =
+        (Arity == 4 || Arity == 8) &&
+        (is_same<T, int>::value || is_same<T, unsigned>::value || is_same<T, float>::value);
+
+    static bool sse41Available() {
+#ifdef __SSE4_1__
+        return true;
+#else
+        static const bool available = []() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.1") != 0;
+        }();
+        return available;
+#endif
+    }
+
+    // lane-wise best of a and b for the heap direction
+    HEAP_TARGET_SSE41 __m128i bestLanes(__m128i a, __m128i b) const {
+        if constexpr (is_same<T, float>::value) {
+            __m128 x = _mm_castsi128_ps(a), y = _mm_castsi128_ps(b);
+            return _mm_castps_si128(isMinHeap ? _mm_min_ps(x, y) : _mm_max_ps(x, y));
+        } else if constexpr (is_same<T, unsigned>::value) {
+            return isMinHeap ? _mm_min_epu32(a, b) : _mm_max_epu32(a, b);
+        } else {
+            return isMinHeap ? _mm_min_epi32(a, b) : _mm_max_epi32(a, b);
+        }
+    }
+
+    // bit i set where lane i of a equals lane i of b
+    HEAP_TARGET_SSE41 static unsigned equalLanes(__m128i a, __m128i b) {
+        if constexpr (is_same<T, float>::value)
+            return _mm_movemask_ps(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        else
+            return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+    }
+
+    // full group of 4 or 8 children: reduce to the min/max lane, then
+    // locate its first occurrence (the child the scalar scan would pick);
+    // -1 when no lane matches, which only NaN floats can cause
+    HEAP_TARGET_SSE41 int bestChildSimd(int first) const {
+        const __m128i* p = reinterpret_cast<const __m128i*>(&data[first]);
+        __m128i lo = _mm_loadu_si128(p);
+        __m128i hi = Arity == 8 ? _mm_loadu_si128(p + 1) : lo;
+        __m128i v = Arity == 8 ? bestLanes(lo, hi) : lo;
+        __m128i r = bestLanes(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        r = bestLanes(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        unsigned mask = equalLanes(lo, r);
+        if constexpr (Arity == 8)
+            mask |= equalLanes(hi, r) << 4;
+        return mask ? first + __builtin_ctz(mask) : -1;
+    }
+#endif
 
-    // heapify upward
+    // heapify upward: shift parents down into the hole, place the value once
     void heapifyUp(int i) {
+        T value = std::move(data[i]);
         while (i > 0) {
             int p = parent(i);
-            if (!compare(data[i], data[p]))
+            if (!compare(value, data[p]))
                 break;
-            swap(data[i], data[p]);
+            data[i] = std::move(data[p]);
             i = p;
         }
+        data[i] = std::move(value);
     }
 
-    // heapify downward
+    // heapify downward: pull the best child up into the hole each level
     void heapifyDown(int i) {
         int sz = data.size();
+        T value = std::move(data[i]);
         while (true) {
-            int l = leftChild(i);
-            int r = rightChild(i);
-            int best = i;
-
-            if (l < sz && compare(data[l], data[best]))
-                best = l;
-            if (r < sz && compare(data[r], data[best]))
-                best = r;
+            int first = firstChild(i);
+            if (first >= sz)
+                break;
 
-            if (best == i)
+            int best = bestChild(first, min(first + Arity, sz));
+            if (!compare(data[best], value))
                 break;
 
-            swap(data[i], data[best]);
+            data[i] = std::move(data[best]);
             i = best;
         }
+        data[i] = std::move(value);
     }
 
 public:
@@ -80,7 +173,7 @@ public:
             throw runtime_error("Heap is empty");
 
         T top = data[0];
-        data[0] = data.back();
+        data[0] = std::move(data.back());
         data.pop_back();
 
         if (!data.empty())
@@ -114,7 +207,9 @@ public:
     // build heap from vector
     void buildHeap(const vector<T>& values) {
         data = values;
-        for (int i = data.size() / 2 - 1; i >= 0; i--)
+        if (data.size() < 2)
+            return;
+        for (int i = parent(data.size() - 1); i >= 0; i--)
             heapifyDown(i);
     }
 
@@ -146,13 +241,25 @@ public:
     int height() const {
         if (data.empty())
             return -1;
-        return static_cast<int>(floor(log2(data.size())));
+        int h = 0;
+        long long width = 1, nodes = 1;  // nodes in levels 0..h
+        while (nodes < (long long)data.size()) {
+            width *= Arity;
+            nodes += width;
+            h++;
+        }
+        return h;
     }
 
     // get all elements
     vector<T> getElements() const {
         return data;
     }
+
+    // total footprint: the heap object plus the element array's capacity
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + data.capacity() * sizeof(T);
+    }
 };
 
 #endif
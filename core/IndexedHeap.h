@@ -0,0 +1,245 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include "HashMap.h"
+
+using namespace std;
+
+// binary heap with a value -> slot position map, kept up to date on every
+// swap, so contains is O(1) and removing or re-prioritising any value is
+// O(log n) instead of a linear scan
+// equal values share one slot with a multiplicity count
+template <typename T>
+class IndexedHeap {
+private:
+    struct Entry {
+        T value;
+        int count;  // how many copies of value are stored
+
+        Entry(const T& v) : value(v), count(1) {}
+    };
+
+    vector<Entry> data;
+    HashMap<T, int, FlatHashing> position;  // value -> index in data
+    bool isMinHeap;  // true = min-heap, false = max-heap
+    int total;       // number of values including duplicates
+
+    // compare based on heap type
+    bool compare(const T& a, const T& b) const {
+        return isMinHeap ? (a < b) : (a > b);
+    }
+
+    // helper functions for indices
+    int parent(int i) const { return (i - 1) / 2; }
+    int leftChild(int i) const { return 2 * i + 1; }
+    int rightChild(int i) const { return 2 * i + 2; }
+
+    // swap two slots and record their new positions
+    void swapEntries(int i, int j) {
+        swap(data[i], data[j]);
+        *position.search(data[i].value) = i;
+        *position.search(data[j].value) = j;
+    }
+
+    // heapify upward
+    void heapifyUp(int i) {
+        while (i > 0) {
+            int p = parent(i);
+            if (!compare(data[i].value, data[p].value))
+                break;
+            swapEntries(i, p);
+            i = p;
+        }
+    }
+
+    // heapify downward
+    void heapifyDown(int i) {
+        int sz = data.size();
+        while (true) {
+            int l = leftChild(i);
+            int r = rightChild(i);
+            int best = i;
+
+            if (l < sz && compare(data[l].value, data[best].value))
+                best = l;
+            if (r < sz && compare(data[r].value, data[best].value))
+                best = r;
+
+            if (best == i)
+                break;
+
+            swapEntries(i, best);
+            i = best;
+        }
+    }
+
+    // remove the slot at index i regardless of its count
+    void removeAt(int i) {
+        int last = data.size() - 1;
+        total -= data[i].count;
+        if (i != last)
+            swapEntries(i, last);
+        position.remove(data[last].value);
+        data.pop_back();
+
+        if (i < (int)data.size()) {
+            heapifyUp(i);
+            heapifyDown(i);
+        }
+    }
+
+public:
+    // constructor
+    IndexedHeap(bool minHeap = true) : isMinHeap(minHeap), total(0) {}
+
+    // insert element
+    void insert(const T& value) {
+        total++;
+        if (int* idx = position.search(value)) {
+            data[*idx].count++;
+            return;
+        }
+        data.push_back(Entry(value));
+        position.insert(value, data.size() - 1);
+        heapifyUp(data.size() - 1);
+    }
+
+    // get top element without removing
+    T peek() const {
+        if (data.empty())
+            throw runtime_error("Heap is empty");
+        return data[0].value;
+    }
+
+    // extract top element
+    T extractTop() {
+        if (data.empty())
+            throw runtime_error("Heap is empty");
+
+        T top = data[0].value;
+        if (data[0].count > 1) {
+            data[0].count--;
+            total--;
+        } else {
+            removeAt(0);
+        }
+        return top;
+    }
+
+    // remove one copy of a specific value, O(log n)
+    void removeValue(const T& value) {
+        int* idx = position.search(value);
+        if (!idx)
+            return;
+
+        if (data[*idx].count > 1) {
+            data[*idx].count--;
+            total--;
+        } else {
+            removeAt(*idx);
+        }
+    }
+
+    // change one copy of oldValue into newValue and restore heap order, O(log n)
+    bool updatePriority(const T& oldValue, const T& newValue) {
+        int* idx = position.search(oldValue);
+        if (!idx)
+            return false;
+        if (oldValue == newValue)
+            return true;
+
+        int i = *idx;
+        if (data[i].count > 1 || position.contains(newValue)) {
+            // oldValue keeps its slot (or loses it), newValue gains a copy
+            removeValue(oldValue);
+            insert(newValue);
+            return true;
+        }
+
+        position.remove(oldValue);
+        data[i].value = newValue;
+        position.insert(newValue, i);
+        heapifyUp(i);
+        heapifyDown(i);
+        return true;
+    }
+
+    // move oldValue towards the top; newValue must not be further from it
+    bool decreaseKey(const T& oldValue, const T& newValue) {
+        if (compare(oldValue, newValue))
+            throw invalid_argument("New key would move away from the top");
+        return updatePriority(oldValue, newValue);
+    }
+
+    // build heap from vector
+    void buildHeap(const vector<T>& values) {
+        clear();
+        for (const T& v : values) {
+            total++;
+            if (int* idx = position.search(v)) {
+                data[*idx].count++;
+            } else {
+                data.push_back(Entry(v));
+                position.insert(v, data.size() - 1);
+            }
+        }
+        for (int i = data.size() / 2 - 1; i >= 0; i--)
+            heapifyDown(i);
+    }
+
+    // check for value, O(1) average
+    bool contains(const T& value) const {
+        return position.contains(value);
+    }
+
+    // same as contains, matching Heap's interface
+    bool search(const T& value) const {
+        return contains(value);
+    }
+
+    // get size
+    int size() const {
+        return total;
+    }
+
+    // check if empty
+    bool isEmpty() const {
+        return data.empty();
+    }
+
+    // clear all elements
+    void clear() {
+        data.clear();
+        position.clear();
+        total = 0;
+    }
+
+    // get heap height
+    int height() const {
+        if (data.empty())
+            return -1;
+        return static_cast<int>(floor(log2(data.size())));
+    }
+
+    // get all elements (duplicates repeated)
+    vector<T> getElements() const {
+        vector<T> result;
+        result.reserve(total);
+        for (const Entry& e : data)
+            for (int c = 0; c < e.count; c++)
+                result.push_back(e.value);
+        return result;
+    }
+
+    // slot array plus position index
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + data.capacity() * sizeof(Entry) + position.getReservedBytes();
+    }
+};
+
+#endif
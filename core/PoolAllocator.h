@@ -0,0 +1,190 @@
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Fixed-size slab allocator for node-based structures
+ *
+ * Objects are carved out of large slabs instead of individual new/delete
+ * calls. Freed slots go onto an intrusive free list and are reused by the
+ * next create(). release() hands every slab back at once, which is how the
+ * owning structure implements clear() and destruction.
+ *
+ * @tparam T Object type (one pool per node type)
+ */
+template<typename T>
+class PoolAllocator {
+private:
+    /**
+     * @brief One slot: either a live object or a free-list link
+     */
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t FirstSlabSlots = 64;     // Size of the first slab
+    static constexpr size_t MaxSlabSlots = 4096;     // Slabs double up to this size
+
+    std::vector<Slot*> slabs;     // Every slab owned by the pool
+    Slot* freeList;               // Recycled slots
+    Slot* bump;                   // Next never-used slot in the newest slab
+    Slot* bumpEnd;                // End of the newest slab
+    size_t nextSlabSlots;         // Size of the next slab to allocate
+    size_t slotsReserved;         // Total slots across all slabs
+    size_t liveCount;             // Objects currently constructed
+
+    Slot* takeSlot() {
+        if (freeList != nullptr) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+
+        if (bump == bumpEnd) {
+            Slot* slab = new Slot[nextSlabSlots];
+            slabs.push_back(slab);
+            bump = slab;
+            bumpEnd = slab + nextSlabSlots;
+            slotsReserved += nextSlabSlots;
+            nextSlabSlots = std::min(nextSlabSlots * 2, MaxSlabSlots);
+        }
+
+        return bump++;
+    }
+
+public:
+    // release() frees every slot at once, so owners may skip per-node
+    // destruction when T is trivially destructible
+    static constexpr bool releasesAll = true;
+
+    PoolAllocator()
+        : freeList(nullptr), bump(nullptr), bumpEnd(nullptr),
+        nextSlabSlots(FirstSlabSlots), slotsReserved(0), liveCount(0) {}
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    ~PoolAllocator() {
+        release();
+    }
+
+    /**
+     * @brief Construct an object in a pooled slot
+     * Time Complexity: O(1) amortized
+     */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = takeSlot();
+        T* object = new (slot->storage) T(std::forward<Args>(args)...);
+        liveCount++;
+        return object;
+    }
+
+    /**
+     * @brief Destroy an object and return its slot to the free list
+     * Time Complexity: O(1)
+     */
+    void destroy(T* object) {
+        if (object == nullptr) return;
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = freeList;
+        freeList = slot;
+        liveCount--;
+    }
+
+    /**
+     * @brief Free every slab in one pass
+     * Objects still alive are not destroyed; the owner must destroy them
+     * first unless T is trivially destructible.
+     * Time Complexity: O(number of slabs)
+     */
+    void release() {
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+        slabs.clear();
+        freeList = nullptr;
+        bump = bumpEnd = nullptr;
+        nextSlabSlots = FirstSlabSlots;
+        slotsReserved = 0;
+        liveCount = 0;
+    }
+
+    /**
+     * @brief Bytes obtained from the system for slabs
+     */
+    size_t bytesReserved() const {
+        return slotsReserved * sizeof(Slot);
+    }
+
+    /**
+     * @brief Bytes occupied by live objects
+     */
+    size_t bytesUsed() const {
+        return liveCount * sizeof(T);
+    }
+
+    /**
+     * @brief Number of live objects
+     */
+    size_t liveObjects() const {
+        return liveCount;
+    }
+};
+
+/**
+ * @brief Plain new/delete allocator with the same interface as PoolAllocator
+ * Useful as a baseline when benchmarking the pool.
+ *
+ * @tparam T Object type
+ */
+template<typename T>
+class NewDeleteAllocator {
+private:
+    size_t liveCount;
+
+public:
+    // Objects must be destroyed one by one; release() cannot reclaim them
+    static constexpr bool releasesAll = false;
+
+    NewDeleteAllocator() : liveCount(0) {}
+
+    NewDeleteAllocator(const NewDeleteAllocator&) = delete;
+    NewDeleteAllocator& operator=(const NewDeleteAllocator&) = delete;
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        T* object = new T(std::forward<Args>(args)...);
+        liveCount++;
+        return object;
+    }
+
+    void destroy(T* object) {
+        if (object == nullptr) return;
+        delete object;
+        liveCount--;
+    }
+
+    void release() {}
+
+    size_t bytesReserved() const {
+        return liveCount * sizeof(T);
+    }
+
+    size_t bytesUsed() const {
+        return liveCount * sizeof(T);
+    }
+
+    size_t liveObjects() const {
+        return liveCount;
+    }
+};
+
+#endif // POOLALLOCATOR_H
@@ -3,39 +3,69 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <new>
+#include <utility>
+#include <cstddef>
 
 using namespace std;
 
-template <typename T>
-class QNode {
-public:
-    T data;
-    QNode* next;
-
-    QNode(T val) : data(val), next(nullptr) {}
-};
-
+// FIFO queue on a power-of-two circular buffer: the head index wraps with a
+// mask, and a full buffer doubles and moves its elements over in order.
+// No per-element allocation, so enqueue/dequeue are O(1) amortized
 template <typename T>
 class Queue {
 private:
-    QNode<T>* frontPtr;
-    QNode<T>* rearPtr;
+    T* buffer;        // raw storage for capacity elements
+    size_t capacity;  // always 0 or a power of two
+    size_t head;      // index of the front element
     int count;
 
+    static constexpr size_t InitialCapacity = 16;
+
+    T* slot(size_t i) const {
+        return buffer + ((head + i) & (capacity - 1));
+    }
+
+    // double the buffer, moving elements so the front lands at index 0
+    void grow() {
+        size_t newCapacity = capacity == 0 ? InitialCapacity : capacity * 2;
+        T* newBuffer = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        for (int i = 0; i < count; i++) {
+            T* old = slot(i);
+            new (newBuffer + i) T(std::move(*old));
+            old->~T();
+        }
+        ::operator delete(buffer);
+        buffer = newBuffer;
+        capacity = newCapacity;
+        head = 0;
+    }
+
 public:
     // constructor
-    Queue() : frontPtr(nullptr), rearPtr(nullptr), count(0) {}
+    Queue() : buffer(nullptr), capacity(0), head(0), count(0) {}
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
 
     // destructor
     ~Queue() {
-        while (!isEmpty()) {
-            dequeue();
+        clear();
+        ::operator delete(buffer);
+    }
+
+    // remove all elements; the buffer is kept for reuse
+    void clear() {
+        for (int i = 0; i < count; i++) {
+            slot(i)->~T();
         }
+        head = 0;
+        count = 0;
     }
 
     // check if empty
     bool isEmpty() const {
-        return frontPtr == nullptr;
+        return count == 0;
     }
 
     // get size
@@ -45,15 +75,22 @@ public:
 
     // add element at rear
     void enqueue(const T& val) {
-        QNode<T>* newNode = new QNode<T>(val);
+        emplace(val);
+    }
 
-        if (isEmpty()) {
-            frontPtr = rearPtr = newNode;
-        } else {
-            rearPtr->next = newNode;
-            rearPtr = newNode;
+    void enqueue(T&& val) {
+        emplace(std::move(val));
+    }
+
+    // construct element in place at rear
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if ((size_t)count == capacity) {
+            grow();
         }
+        T* rear = new (slot(count)) T(std::forward<Args>(args)...);
         count++;
+        return *rear;
     }
 
     // remove element from front
@@ -62,31 +99,41 @@ public:
             throw runtime_error("Queue is empty");
         }
 
-        QNode<T>* temp = frontPtr;
-        frontPtr = frontPtr->next;
-        delete temp;
+        buffer[head].~T();
+        head = (head + 1) & (capacity - 1);
         count--;
-
-        if (frontPtr == nullptr)
-            rearPtr = nullptr;
     }
 
     // get front element
-    T front() const {
+    const T& front() const {
         if (isEmpty()) {
             throw runtime_error("Queue is empty");
         }
-        return frontPtr->data;
+        return buffer[head];
     }
 
     // get rear element
-    T back() const {
+    const T& back() const {
         if (isEmpty()) {
             throw runtime_error("Queue is empty");
         }
-        return rearPtr->data;
+        return *slot(count - 1);
+    }
+
+    // bytes reserved by the buffer
+    size_t getReservedBytes() const {
+        return capacity * sizeof(T);
     }
 
+    // bytes occupied by live elements
+    size_t getUsedBytes() const {
+        return count * sizeof(T);
+    }
+
+    // total footprint
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + getReservedBytes();
+    }
 
 };
 
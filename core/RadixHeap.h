@@ -0,0 +1,143 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+// monotone min-priority queue for integer keys (radix heap)
+// keys are bucketed by the highest bit in which they differ from the last
+// extracted key, so inserts are O(1) and each key is redistributed at most
+// once per bit: O(log C) amortized extractTop with no comparisons between
+// keys in the same bucket
+// requirement: every inserted key must be >= the last extracted key, which
+// holds for Dijkstra-style distances and event timestamps
+template <typename K>
+class RadixHeap {
+private:
+    static_assert(is_integral<K>::value, "RadixHeap requires an integer key type");
+
+    using U = typename make_unsigned<K>::type;
+    static constexpr int Bits = sizeof(U) * 8;
+
+    vector<U> buckets[Bits + 1];
+    U last;       // last extracted key (encoded); every stored key is >= last
+    int count;
+
+    // order-preserving map to unsigned: flip the sign bit of signed keys
+    static U encode(K key) {
+        U u = static_cast<U>(key);
+        if (is_signed<K>::value)
+            u ^= U(1) << (Bits - 1);
+        return u;
+    }
+
+    static K decode(U u) {
+        if (is_signed<K>::value)
+            u ^= U(1) << (Bits - 1);
+        return static_cast<K>(u);
+    }
+
+    static int highestBit(U x) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (Bits > 32)
+            return 63 - __builtin_clzll(static_cast<unsigned long long>(x));
+        return 31 - __builtin_clz(static_cast<unsigned>(x));
+#else
+        int b = -1;
+        while (x) { x >>= 1; b++; }
+        return b;
+#endif
+    }
+
+    // bucket 0 holds keys equal to last, bucket i keys whose highest
+    // differing bit from last is i - 1
+    int bucketOf(U x) const {
+        return x == last ? 0 : highestBit(x ^ last) + 1;
+    }
+
+    // make sure bucket 0 holds the minimum: empty the first non-empty bucket
+    // into lower ones relative to its smallest key
+    void pull() {
+        if (!buckets[0].empty())
+            return;
+
+        int i = 1;
+        while (buckets[i].empty())
+            i++;
+
+        last = *min_element(buckets[i].begin(), buckets[i].end());
+        for (U x : buckets[i])
+            buckets[bucketOf(x)].push_back(x);
+        buckets[i].clear();
+    }
+
+public:
+    // constructor
+    RadixHeap() : last(0), count(0) {}
+
+    // insert key, O(1)
+    void insert(K key) {
+        U u = encode(key);
+        if (u < last)
+            throw invalid_argument("RadixHeap keys must not be below the last extracted key");
+        buckets[bucketOf(u)].push_back(u);
+        count++;
+    }
+
+    // get smallest key without removing; does not redistribute, so it does
+    // not raise the monotone bound the way extractTop does
+    K peek() const {
+        if (count == 0)
+            throw runtime_error("Heap is empty");
+        int i = 0;
+        while (buckets[i].empty())
+            i++;
+        if (i == 0)
+            return decode(last);
+        return decode(*min_element(buckets[i].begin(), buckets[i].end()));
+    }
+
+    // extract smallest key
+    K extractTop() {
+        if (count == 0)
+            throw runtime_error("Heap is empty");
+        pull();
+        buckets[0].pop_back();
+        count--;
+        return decode(last);
+    }
+
+    // get size
+    int size() const {
+        return count;
+    }
+
+    // check if empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // clear all elements and the monotone bound
+    void clear() {
+        for (auto& bucket : buckets)
+            bucket.clear();
+        last = 0;
+        count = 0;
+    }
+
+    // bucket storage in bytes
+    size_t getMemoryUsage() const {
+        size_t memory = sizeof(*this);
+        for (const auto& bucket : buckets)
+            memory += bucket.capacity() * sizeof(U);
+        return memory;
+    }
+};
+
+#endif
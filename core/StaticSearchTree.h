@@ -0,0 +1,123 @@
+#ifndef STATICSEARCHTREE_H
+#define STATICSEARCHTREE_H
+
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// read-only search index over sorted keys, stored in Eytzinger (BFS) order:
+// the children of slot k are 2k and 2k+1 (1-based), so a lookup is a
+// branch-free walk down one array and the next levels can be prefetched
+// built by BST::freeze() from an in-order traversal
+template <typename T>
+class StaticSearchTree {
+private:
+    vector<T> data;   // data[0] is unused
+    size_t count;
+
+    // levels prefetched ahead: 16 consecutive slots hold a node's 4th-generation descendants
+    static constexpr size_t PrefetchStride = 16;
+
+    static int trailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int n = 0;
+        while (!(x & 1)) { x >>= 1; n++; }
+        return n;
+#endif
+    }
+
+    // place sorted[pos...] into slot k and its subtree, in-order
+    void build(const vector<T>& sorted, size_t& pos, size_t k) {
+        if (k > count) return;
+        build(sorted, pos, 2 * k);
+        data[k] = sorted[pos++];
+        build(sorted, pos, 2 * k + 1);
+    }
+
+    // slot of the first key >= x, or 0 if there is none
+    size_t lowerBound(const T& x) const {
+        size_t k = 1;
+        while (k <= count) {
+#if defined(__GNUC__) || defined(__clang__)
+            if (k * PrefetchStride <= count)
+                __builtin_prefetch(&data[k * PrefetchStride]);
+#endif
+            k = 2 * k + (data[k] < x);
+        }
+        // undo the trailing right turns plus the final step
+        return k >> (trailingZeros(~static_cast<uint64_t>(k)) + 1);
+    }
+
+    // in-order successor of slot k, or 0 past the end
+    size_t successor(size_t k) const {
+        if (2 * k + 1 <= count) {
+            k = 2 * k + 1;
+            while (2 * k <= count) k = 2 * k;
+            return k;
+        }
+        return k >> (trailingZeros(~static_cast<uint64_t>(k)) + 1);
+    }
+
+public:
+    StaticSearchTree() : data(1), count(0) {}
+
+    // keys must already be sorted ascending
+    explicit StaticSearchTree(const vector<T>& sorted) : data(sorted.size() + 1), count(sorted.size()) {
+        size_t pos = 0;
+        build(sorted, pos, 1);
+    }
+
+    bool searchValue(const T& target) const {
+        size_t k = lowerBound(target);
+        return k != 0 && !(target < data[k]);
+    }
+
+    // O(log n + k) sorted keys in [minVal, maxVal]
+    vector<T> rangeQuery(const T& minVal, const T& maxVal) const {
+        vector<T> result;
+        forEachInRange(minVal, maxVal, [&result](const T& val) {
+            result.push_back(val);
+        });
+        return result;
+    }
+
+    template <typename Func>
+    void forEachInRange(const T& minVal, const T& maxVal, Func visit) const {
+        if (maxVal < minVal) return;
+        for (size_t k = lowerBound(minVal); k != 0 && !(maxVal < data[k]); k = successor(k))
+            visit(data[k]);
+    }
+
+    T findMin() const {
+        if (count == 0) throw runtime_error("Tree is empty!");
+        size_t k = 1;
+        while (2 * k <= count) k = 2 * k;
+        return data[k];
+    }
+
+    T findMax() const {
+        if (count == 0) throw runtime_error("Tree is empty!");
+        size_t k = 1;
+        while (2 * k + 1 <= count) k = 2 * k + 1;
+        return data[k];
+    }
+
+    int size() const {
+        return count;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + data.capacity() * sizeof(T);
+    }
+};
+
+#endif
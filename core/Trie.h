@@ -2,155 +2,748 @@
 #define TRIE_H
 
 #include <iostream>
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include "PoolAllocator.h"
+#include "Heap.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRIE_HAVE_SSE2 1
+#endif
 
 using namespace std;
 
-class TrieNode {
-public:
-    unordered_map<char, TrieNode*> children;
+// adaptive radix tree style nodes: a node grows from 4 to 16 to 48 to 256
+// child slots as children are added and shrinks back on removal, so sparse
+// nodes stay small and dense ones get direct indexing
+
+// common header shared by every node type
+// in path-compressed mode a node also carries the fragment of characters
+// that follow the edge leading into it; otherwise prefixLen stays 0
+// maxScore caches the best word score in the subtree so completions can
+// skip whole subtrees
+struct TrieNode {
+    enum Type : uint8_t { Type4, Type16, Type48, Type256 };
+
+    uint8_t type;
     bool isEndOfWord;
+    uint16_t count;      // number of children
+    uint32_t prefixLen;  // fragment length
+    const char* prefix;  // fragment, points into the trie's key store
+    uint32_t score;      // score of the word ending here
+    uint32_t maxScore;   // best score of any word in this subtree
+
+    TrieNode(uint8_t t)
+        : type(t), isEndOfWord(false), count(0), prefixLen(0), prefix(nullptr), score(0), maxScore(0) {}
+};
+
+// up to 4 children, keys kept sorted
+struct TrieNode4 : TrieNode {
+    unsigned char keys[4];
+    TrieNode* children[4];
+
+    TrieNode4() : TrieNode(Type4) {}
+};
+
+// up to 16 children, keys kept sorted and searched 16 at a time with SSE2
+struct TrieNode16 : TrieNode {
+    unsigned char keys[16];
+    TrieNode* children[16];
+
+    TrieNode16() : TrieNode(Type16) {}
+};
+
+// up to 48 children behind a 256-entry byte index (0 = no child, else slot + 1)
+struct TrieNode48 : TrieNode {
+    unsigned char childIndex[256];
+    TrieNode* children[48];
+
+    TrieNode48() : TrieNode(Type48) {
+        memset(childIndex, 0, sizeof(childIndex));
+        memset(children, 0, sizeof(children));
+    }
+};
 
-    TrieNode() : isEndOfWord(false) {}
+// one slot per byte value
+struct TrieNode256 : TrieNode {
+    TrieNode* children[256];
+
+    TrieNode256() : TrieNode(Type256) {
+        memset(children, 0, sizeof(children));
+    }
 };
 
 class Trie {
 private:
+    // one pool per node size; every node type is trivially destructible,
+    // so releasing the pools frees the whole trie
+    PoolAllocator<TrieNode4> pool4;
+    PoolAllocator<TrieNode16> pool16;
+    PoolAllocator<TrieNode48> pool48;
+    PoolAllocator<TrieNode256> pool256;
     TrieNode* root;
     int wordCount;
-    size_t memoryUsed;
-
-    // helper for insertion
-    void insertHelper(TrieNode* node, const string& word, int index) {
-        if (index == word.length()) {
-            if (!node->isEndOfWord) {
-                node->isEndOfWord = true;
-                wordCount++;
-            }
-            return;
+    bool compressed;                 // path-compressed (radix) mode
+    vector<TrieNode**> path;         // child slots visited by insert/remove
+    vector<unsigned char> pathKeys;  // edge keys leading into them
+
+    // copies of inserted keys; fragments point into them at the string
+    // depth where their node starts, so splitting a fragment or merging it
+    // with its parent's only moves the pointer
+    // removals leave copies no fragment needs any more; once the stored
+    // bytes exceed twice what the live words need, compactKeys() rewrites
+    // the store with one copy per leaf
+    static constexpr size_t KeyBlockSize = 4096;
+    vector<char*> keyBlocks;
+    size_t keyBlockUsed;  // bytes used in the newest block
+    size_t keyBytes;      // bytes reserved across all blocks
+    size_t keyBytesStored;  // bytes copied into the store since the last compaction
+    size_t wordBytes;       // total length of the words in the trie
+
+    void destroyNode(TrieNode* node) {
+        switch (node->type) {
+        case TrieNode::Type4: pool4.destroy(static_cast<TrieNode4*>(node)); break;
+        case TrieNode::Type16: pool16.destroy(static_cast<TrieNode16*>(node)); break;
+        case TrieNode::Type48: pool48.destroy(static_cast<TrieNode48*>(node)); break;
+        default: pool256.destroy(static_cast<TrieNode256*>(node)); break;
         }
+    }
 
-        char ch = word[index];
-        if (node->children.find(ch) == node->children.end()) {
-            node->children[ch] = new TrieNode();
-            memoryUsed += sizeof(TrieNode);
-        }
+    // position of key in a sorted key array of n entries, or -1
+    static int findKey16(const unsigned char* keys, int n, unsigned char key) {
+#ifdef TRIE_HAVE_SSE2
+        __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(key)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)));
+        unsigned mask = _mm_movemask_epi8(cmp) & ((1u << n) - 1);
+        return mask ? __builtin_ctz(mask) : -1;
+#else
+        for (int i = 0; i < n; i++)
+            if (keys[i] == key) return i;
+        return -1;
+#endif
+    }
 
-        insertHelper(node->children[ch], word, index + 1);
+    // slot holding the child for key, or nullptr
+    static TrieNode* const* findChild(const TrieNode* node, unsigned char key) {
+        switch (node->type) {
+        case TrieNode::Type4: {
+            const TrieNode4* n = static_cast<const TrieNode4*>(node);
+            for (int i = 0; i < n->count; i++)
+                if (n->keys[i] == key) return &n->children[i];
+            return nullptr;
+        }
+        case TrieNode::Type16: {
+            const TrieNode16* n = static_cast<const TrieNode16*>(node);
+            int i = findKey16(n->keys, n->count, key);
+            return i < 0 ? nullptr : &n->children[i];
+        }
+        case TrieNode::Type48: {
+            const TrieNode48* n = static_cast<const TrieNode48*>(node);
+            unsigned char idx = n->childIndex[key];
+            return idx ? &n->children[idx - 1] : nullptr;
+        }
+        default: {
+            const TrieNode256* n = static_cast<const TrieNode256*>(node);
+            return n->children[key] ? &n->children[key] : nullptr;
+        }
+        }
     }
 
-    // helper for search
-    bool searchHelper(TrieNode* node, const string& word, int index) const {
-        if (!node)
-            return false;
-        if (index == word.length())
-            return node->isEndOfWord;
+    static TrieNode** findChild(TrieNode* node, unsigned char key) {
+        return const_cast<TrieNode**>(findChild(static_cast<const TrieNode*>(node), key));
+    }
 
-        char ch = word[index];
-        if (node->children.find(ch) == node->children.end())
-            return false;
+    // visit children in key order
+    template <typename Func>
+    static void forEachChild(const TrieNode* node, Func visit) {
+        switch (node->type) {
+        case TrieNode::Type4: {
+            const TrieNode4* n = static_cast<const TrieNode4*>(node);
+            for (int i = 0; i < n->count; i++) visit(n->keys[i], n->children[i]);
+            break;
+        }
+        case TrieNode::Type16: {
+            const TrieNode16* n = static_cast<const TrieNode16*>(node);
+            for (int i = 0; i < n->count; i++) visit(n->keys[i], n->children[i]);
+            break;
+        }
+        case TrieNode::Type48: {
+            const TrieNode48* n = static_cast<const TrieNode48*>(node);
+            for (int k = 0; k < 256; k++)
+                if (n->childIndex[k]) visit(static_cast<unsigned char>(k), n->children[n->childIndex[k] - 1]);
+            break;
+        }
+        default: {
+            const TrieNode256* n = static_cast<const TrieNode256*>(node);
+            for (int k = 0; k < 256; k++)
+                if (n->children[k]) visit(static_cast<unsigned char>(k), n->children[k]);
+            break;
+        }
+        }
+    }
 
-        return searchHelper(node->children.at(ch), word, index + 1);
+    // insert key into a sorted key/child array with room for one more
+    static TrieNode** insertSorted(unsigned char* keys, TrieNode** children, int n,
+                                   unsigned char key, TrieNode* child) {
+        int pos = 0;
+        while (pos < n && keys[pos] < key) pos++;
+        memmove(keys + pos + 1, keys + pos, n - pos);
+        memmove(children + pos + 1, children + pos, (n - pos) * sizeof(TrieNode*));
+        keys[pos] = key;
+        children[pos] = child;
+        return &children[pos];
     }
 
-    // helper for deletion
-    bool removeHelper(TrieNode* node, const string& word, int index) {
-        if (!node)
-            return false;
+    // move the node in ref into a node of another size class
+    template <typename T>
+    T* replaceNode(TrieNode** ref, T* resized) {
+        TrieNode* old = *ref;
+        resized->isEndOfWord = old->isEndOfWord;
+        resized->prefixLen = old->prefixLen;
+        resized->prefix = old->prefix;
+        resized->score = old->score;
+        resized->maxScore = old->maxScore;
+        int slot = 0;
+        forEachChild(old, [&](unsigned char k, TrieNode* c) {
+            placeChild(resized, k, c, slot++);
+        });
+        resized->count = old->count;
+        destroyNode(old);
+        *ref = resized;
+        return resized;
+    }
 
-        if (index == word.length()) {
-            if (!node->isEndOfWord)
-                return false;
+    // append a child in key order while copying (keys arrive sorted)
+    static void placeChild(TrieNode4* n, unsigned char k, TrieNode* c, int slot) {
+        n->keys[slot] = k; n->children[slot] = c;
+    }
+    static void placeChild(TrieNode16* n, unsigned char k, TrieNode* c, int slot) {
+        n->keys[slot] = k; n->children[slot] = c;
+    }
+    static void placeChild(TrieNode48* n, unsigned char k, TrieNode* c, int slot) {
+        n->children[slot] = c; n->childIndex[k] = slot + 1;
+    }
+    static void placeChild(TrieNode256* n, unsigned char k, TrieNode* c, int) {
+        n->children[k] = c;
+    }
 
-            node->isEndOfWord = false;
-            wordCount--;
-            return node->children.empty();
+    // add child under key to the node in ref, growing it when full;
+    // returns the slot now holding child
+    TrieNode** addChild(TrieNode** ref, unsigned char key, TrieNode* child) {
+        TrieNode* node = *ref;
+        switch (node->type) {
+        case TrieNode::Type4: {
+            if (node->count == 4)
+                return addChild16(replaceNode(ref, pool16.create()), key, child);
+            TrieNode4* n = static_cast<TrieNode4*>(node);
+            return insertSorted(n->keys, n->children, n->count++, key, child);
+        }
+        case TrieNode::Type16: {
+            if (node->count == 16)
+                return addChild48(replaceNode(ref, pool48.create()), key, child);
+            return addChild16(static_cast<TrieNode16*>(node), key, child);
         }
+        case TrieNode::Type48: {
+            if (node->count == 48)
+                return addChild256(replaceNode(ref, pool256.create()), key, child);
+            return addChild48(static_cast<TrieNode48*>(node), key, child);
+        }
+        default:
+            return addChild256(static_cast<TrieNode256*>(node), key, child);
+        }
+    }
 
-        char ch = word[index];
-        if (node->children.find(ch) == node->children.end())
-            return false;
+    static TrieNode** addChild16(TrieNode16* n, unsigned char key, TrieNode* child) {
+        return insertSorted(n->keys, n->children, n->count++, key, child);
+    }
 
-        bool shouldDelete = removeHelper(node->children[ch], word, index + 1);
+    static TrieNode** addChild48(TrieNode48* n, unsigned char key, TrieNode* child) {
+        int slot = 0;
+        while (n->children[slot]) slot++;
+        n->children[slot] = child;
+        n->childIndex[key] = slot + 1;
+        n->count++;
+        return &n->children[slot];
+    }
 
-        if (shouldDelete) {
-            delete node->children[ch];
-            node->children.erase(ch);
-            memoryUsed -= sizeof(TrieNode);
-        }
+    static TrieNode** addChild256(TrieNode256* n, unsigned char key, TrieNode* child) {
+        n->children[key] = child;
+        n->count++;
+        return &n->children[key];
+    }
 
-        return node->children.empty() && !node->isEndOfWord;
+    // drop the child under key from the node in ref, shrinking it once it
+    // falls well below the next smaller capacity
+    void removeChild(TrieNode** ref, unsigned char key) {
+        TrieNode* node = *ref;
+        switch (node->type) {
+        case TrieNode::Type4: {
+            TrieNode4* n = static_cast<TrieNode4*>(node);
+            int i = 0;
+            while (n->keys[i] != key) i++;
+            memmove(n->keys + i, n->keys + i + 1, n->count - i - 1);
+            memmove(n->children + i, n->children + i + 1, (n->count - i - 1) * sizeof(TrieNode*));
+            n->count--;
+            break;
+        }
+        case TrieNode::Type16: {
+            TrieNode16* n = static_cast<TrieNode16*>(node);
+            int i = findKey16(n->keys, n->count, key);
+            memmove(n->keys + i, n->keys + i + 1, n->count - i - 1);
+            memmove(n->children + i, n->children + i + 1, (n->count - i - 1) * sizeof(TrieNode*));
+            n->count--;
+            if (n->count <= 3)
+                replaceNode(ref, pool4.create());
+            break;
+        }
+        case TrieNode::Type48: {
+            TrieNode48* n = static_cast<TrieNode48*>(node);
+            n->children[n->childIndex[key] - 1] = nullptr;
+            n->childIndex[key] = 0;
+            n->count--;
+            if (n->count <= 12)
+                replaceNode(ref, pool16.create());
+            break;
+        }
+        default: {
+            TrieNode256* n = static_cast<TrieNode256*>(node);
+            n->children[key] = nullptr;
+            n->count--;
+            if (n->count <= 37)
+                replaceNode(ref, pool48.create());
+            break;
+        }
+        }
     }
 
-    // collect all words
-    void collectWords(TrieNode* node, string current, vector<string>& result) const {
-        if (!node)
-            return;
+    // collect all words, reusing one buffer for the current prefix
+    void collectWords(const TrieNode* node, string& current, vector<string>& result) const {
+        size_t depth = current.size();
+        if (node->prefixLen > 0)
+            current.append(node->prefix, node->prefixLen);
 
         if (node->isEndOfWord)
             result.push_back(current);
 
-        for (auto& pair : node->children) {
-            collectWords(pair.second, current + pair.first, result);
+        forEachChild(node, [&](unsigned char k, const TrieNode* child) {
+            current.push_back(static_cast<char>(k));
+            collectWords(child, current, result);
+            current.pop_back();
+        });
+        current.resize(depth);
+    }
+
+    // node whose subtree holds every word starting with prefix, or nullptr;
+    // the prefix may end inside that node's fragment, which starts at
+    // string depth *start
+    const TrieNode* findNode(const string& prefix, size_t* start = nullptr) const {
+        const TrieNode* node = root;
+        size_t i = 0, n = prefix.length();
+        while (true) {
+            if (start)
+                *start = i;
+            size_t len = min<size_t>(node->prefixLen, n - i);
+            if (!fragmentEquals(node, prefix.data() + i, len))
+                return nullptr;
+            i += len;
+            if (i == n)
+                return node;
+
+            TrieNode* const* slot = findChild(node, static_cast<unsigned char>(prefix[i]));
+            if (!slot)
+                return nullptr;
+            node = *slot;
+            i++;
         }
     }
 
-    // free memory
-    void freeTrie(TrieNode* node) {
-        if (!node)
-            return;
-        for (auto& pair : node->children)
-            freeTrie(pair.second);
-        delete node;
+    // first len characters of node's fragment equal s
+    static bool fragmentEquals(const TrieNode* node, const char* s, size_t len) {
+        return len == 0 || memcmp(node->prefix, s, len) == 0;
+    }
+
+    // copy of word in the key store
+    const char* storeKey(const string& word) {
+        size_t n = word.length();
+        if (keyBlocks.empty() || keyBlockUsed + n > KeyBlockSize) {
+            size_t blockSize = max(n, KeyBlockSize);
+            keyBlocks.push_back(new char[blockSize]);
+            keyBlockUsed = 0;
+            keyBytes += blockSize;
+        }
+        char* copy = keyBlocks.back() + keyBlockUsed;
+        memcpy(copy, word.data(), n);
+        keyBlockUsed += n;
+        keyBytesStored += n;
+        return copy;
+    }
+
+    // point the fragments of node's subtree into fresh key copies, one per
+    // leaf; current spells the path up to node's fragment. Returns the copy
+    // made for the subtree's first leaf, which every node on the way shares,
+    // so merges can still extend a fragment backwards
+    const char* rekey(TrieNode* node, string& current) {
+        size_t depth = current.size();
+        if (node->prefixLen > 0)
+            current.append(node->prefix, node->prefixLen);
+
+        const char* copy = nullptr;
+        if (node->count == 0) {
+            copy = storeKey(current);
+        } else {
+            forEachChild(node, [&](unsigned char key, TrieNode* child) {
+                current.push_back(static_cast<char>(key));
+                const char* leafCopy = rekey(child, current);
+                current.pop_back();
+                if (!copy)
+                    copy = leafCopy;
+            });
+        }
+        node->prefix = copy + depth;
+        current.resize(depth);
+        return copy;
+    }
+
+    // rebuild the key store from the live fragments, dropping the copies
+    // that removals left behind; the old blocks stay readable until every
+    // fragment has been re-pointed
+    void compactKeys() {
+        vector<char*> oldBlocks;
+        oldBlocks.swap(keyBlocks);
+        keyBlockUsed = 0;
+        keyBytes = 0;
+        keyBytesStored = 0;
+
+        if (root->count > 0) {
+            string current;
+            rekey(root, current);
+        }
+
+        for (char* block : oldBlocks)
+            delete[] block;
+    }
+
+    // split the node in ref after the first m fragment characters: a new
+    // parent takes those m characters and the old node keeps the rest
+    TrieNode* splitNode(TrieNode** ref, uint32_t m) {
+        TrieNode* node = *ref;
+        TrieNode4* parent = pool4.create();
+        parent->prefix = node->prefix;
+        parent->prefixLen = m;
+        parent->maxScore = node->maxScore;
+
+        unsigned char key = static_cast<unsigned char>(node->prefix[m]);
+        node->prefix += m + 1;
+        node->prefixLen -= m + 1;
+
+        insertSorted(parent->keys, parent->children, parent->count++, key, node);
+        *ref = parent;
+        return parent;
+    }
+
+    // fold the only child of the node in ref into it (compressed mode)
+    void mergeWithChild(TrieNode** ref) {
+        TrieNode* node = *ref;
+        TrieNode* child = nullptr;
+        forEachChild(node, [&child](unsigned char, TrieNode* c) { child = c; });
+
+        // in the stored key the child's fragment directly follows the
+        // node's fragment and the edge key
+        child->prefix -= node->prefixLen + 1;
+        child->prefixLen += node->prefixLen + 1;
+        *ref = child;
+        destroyNode(node);
+    }
+
+    // recompute a node's cached subtree maximum from its children
+    static void updateMaxScore(TrieNode* node) {
+        uint32_t best = node->isEndOfWord ? node->score : 0;
+        forEachChild(node, [&best](unsigned char, const TrieNode* child) {
+            best = max(best, child->maxScore);
+        });
+        node->maxScore = best;
+    }
+
+    // entry in the completion search: a subtree bounded by its maxScore,
+    // or a finished word with its exact score
+    struct Candidate {
+        uint32_t score;
+        int expansion;  // index into the expansion list
+        bool isWord;
+
+        // at equal scores a word beats a subtree, so it is reported first
+        bool operator<(const Candidate& o) const {
+            return score < o.score || (score == o.score && isWord < o.isWord);
+        }
+        bool operator>(const Candidate& o) const {
+            return o < *this;
+        }
+    };
+
+    // node reached during the completion search, linked to its parent
+    // so the word is spelled out only when it makes the result
+    struct Expansion {
+        const TrieNode* node;
+        int parent;
+        unsigned char key;
+    };
+
+    string spell(const vector<Expansion>& expansions, int e, const string& prefix, size_t start) const {
+        vector<int> chain;
+        for (; e >= 0; e = expansions[e].parent)
+            chain.push_back(e);
+
+        string word(prefix, 0, start);
+        for (int j = chain.size() - 1; j >= 0; j--) {
+            const Expansion& x = expansions[chain[j]];
+            if (x.parent >= 0)
+                word.push_back(static_cast<char>(x.key));
+            if (x.node->prefixLen > 0)
+                word.append(x.node->prefix, x.node->prefixLen);
+        }
+        return word;
+    }
+
+    void releaseAll() {
+        pool4.release();
+        pool16.release();
+        pool48.release();
+        pool256.release();
+        for (char* block : keyBlocks)
+            delete[] block;
+        keyBlocks.clear();
+        keyBlockUsed = 0;
+        keyBytes = 0;
+        keyBytesStored = 0;
+        wordBytes = 0;
     }
 
 public:
-    // constructor
-    Trie() : wordCount(0), memoryUsed(sizeof(TrieNode)) {
-        root = new TrieNode();
+    // constructor; compressed = true stores single-child chains as one
+    // node carrying a string fragment (radix / Patricia trie)
+    Trie(bool compressed = false)
+        : wordCount(0), compressed(compressed), keyBlockUsed(0), keyBytes(0),
+          keyBytesStored(0), wordBytes(0) {
+        root = pool4.create();
     }
 
+    Trie(const Trie&) = delete;
+    Trie& operator=(const Trie&) = delete;
+
     // destructor
     ~Trie() {
-        freeTrie(root);
+        releaseAll();
+    }
+
+    // remove all words
+    void clear() {
+        releaseAll();
+        root = pool4.create();
+        wordCount = 0;
     }
 
-    // insert word
-    void insert(const string& word) {
+    // insert word; inserting it again adds weight to its score, so by
+    // default the score is how often the word was inserted
+    void insert(const string& word, uint32_t weight = 1) {
         if (word.empty())
             throw invalid_argument("Empty word not allowed");
-        insertHelper(root, word, 0);
+
+        TrieNode** ref = &root;
+        path.clear();
+        path.push_back(ref);
+        size_t i = 0, n = word.length();
+        while (true) {
+            TrieNode* node = *ref;
+
+            // match the fragment, splitting it where the word diverges
+            uint32_t m = 0;
+            while (m < node->prefixLen && i + m < n && node->prefix[m] == word[i + m])
+                m++;
+            if (m < node->prefixLen)
+                node = splitNode(ref, m);
+            i += m;
+
+            if (i == n)
+                break;
+
+            unsigned char key = static_cast<unsigned char>(word[i]);
+            TrieNode** slot = findChild(node, key);
+            i++;
+            if (slot) {
+                ref = slot;
+                path.push_back(ref);
+                continue;
+            }
+
+            TrieNode* leaf = pool4.create();
+            ref = addChild(ref, key, leaf);
+            path.push_back(ref);
+            if (compressed) {
+                // the whole remaining suffix becomes one (possibly empty)
+                // fragment; it still points into the stored key so that
+                // a later merge can extend it backwards
+                leaf->prefix = storeKey(word) + i;
+                leaf->prefixLen = n - i;
+                break;
+            }
+        }
+
+        TrieNode* node = *ref;
+        if (!node->isEndOfWord) {
+            node->isEndOfWord = true;
+            wordCount++;
+            wordBytes += n;
+        }
+        node->score += weight;
+
+        // scores only grow on insert, so the cached maxima just take the max
+        for (TrieNode** slot : path)
+            (*slot)->maxScore = max((*slot)->maxScore, node->score);
+    }
+
+    // score of word, 0 if absent
+    uint32_t getScore(const string& word) const {
+        const TrieNode* node = root;
+        size_t i = 0, n = word.length();
+        while (true) {
+            if (n - i < node->prefixLen || !fragmentEquals(node, word.data() + i, node->prefixLen))
+                return 0;
+            i += node->prefixLen;
+            if (i == n)
+                return node->isEndOfWord ? node->score : 0;
+
+            TrieNode* const* slot = findChild(node, static_cast<unsigned char>(word[i]));
+            if (!slot)
+                return 0;
+            node = *slot;
+            i++;
+        }
     }
 
     // search for word
     bool search(const string& word) const {
-        return searchHelper(root, word, 0);
+        const TrieNode* node = root;
+        size_t i = 0, n = word.length();
+        while (true) {
+            if (n - i < node->prefixLen || !fragmentEquals(node, word.data() + i, node->prefixLen))
+                return false;
+            i += node->prefixLen;
+            if (i == n)
+                return node->isEndOfWord;
+
+            TrieNode* const* slot = findChild(node, static_cast<unsigned char>(word[i]));
+            if (!slot)
+                return false;
+            node = *slot;
+            i++;
+        }
     }
 
-    // remove word
+    // remove word, pruning nodes that no longer lead to any word
     void remove(const string& word) {
-        removeHelper(root, word, 0);
+        path.clear();
+        pathKeys.clear();
+        path.push_back(&root);
+        pathKeys.push_back(0);
+
+        size_t i = 0, n = word.length();
+        while (true) {
+            const TrieNode* node = *path.back();
+            if (n - i < node->prefixLen || !fragmentEquals(node, word.data() + i, node->prefixLen))
+                return;
+            i += node->prefixLen;
+            if (i == n)
+                break;
+
+            unsigned char key = static_cast<unsigned char>(word[i]);
+            TrieNode** slot = findChild(*path.back(), key);
+            if (!slot)
+                return;
+            path.push_back(slot);
+            pathKeys.push_back(key);
+            i++;
+        }
+
+        TrieNode* node = *path.back();
+        if (!node->isEndOfWord)
+            return;
+        node->isEndOfWord = false;
+        node->score = 0;
+        wordCount--;
+        wordBytes -= n;
+
+        int d = path.size() - 1;
+        for (; d > 0; d--) {
+            node = *path[d];
+            if (node->count > 0 || node->isEndOfWord)
+                break;
+            destroyNode(node);
+            removeChild(path[d - 1], pathKeys[d]);
+        }
+
+        // a non-word node left with a single child is folded into it
+        if (compressed && d > 0 && !(*path[d])->isEndOfWord && (*path[d])->count == 1)
+            mergeWithChild(path[d]);
+
+        // the removed score may have been the maximum of every ancestor
+        for (; d >= 0; d--)
+            updateMaxScore(*path[d]);
+
+        // dead copies outweigh the live words: reclaim them
+        if (compressed && keyBytesStored > 2 * wordBytes + KeyBlockSize)
+            compactKeys();
     }
 
-    // get all words
+    // get all words, in byte order
     vector<string> getAllWords() const {
         vector<string> result;
-        collectWords(root, "", result);
+        result.reserve(wordCount);
+        string current;
+        collectWords(root, current, result);
         return result;
     }
 
     // check if prefix exists
     bool startsWith(const string& prefix) const {
-        TrieNode* node = root;
-        for (char ch : prefix) {
-            if (node->children.find(ch) == node->children.end())
-                return false;
-            node = node->children[ch];
+        return findNode(prefix) != nullptr;
+    }
+
+    // k highest-scored words starting with prefix, best first
+    // best-first search over cached subtree maxima: only subtrees that can
+    // still beat the k-th result are opened, and only the k results are
+    // turned into strings
+    vector<string> completions(const string& prefix, int k) const {
+        vector<string> result;
+        size_t start = 0;
+        const TrieNode* top = findNode(prefix, &start);
+        if (!top || k <= 0)
+            return result;
+
+        vector<Expansion> expansions;
+        Heap<Candidate, 4> frontier(false);  // max-heap
+        expansions.push_back({top, -1, 0});
+        frontier.insert({top->maxScore, 0, false});
+
+        while ((int)result.size() < k && !frontier.isEmpty()) {
+            Candidate c = frontier.extractTop();
+            if (c.isWord) {
+                result.push_back(spell(expansions, c.expansion, prefix, start));
+                continue;
+            }
+
+            const TrieNode* node = expansions[c.expansion].node;
+            if (node->isEndOfWord)
+                frontier.insert({node->score, c.expansion, true});
+            forEachChild(node, [&](unsigned char key, const TrieNode* child) {
+                expansions.push_back({child, c.expansion, key});
+                frontier.insert({child->maxScore, (int)expansions.size() - 1, false});
+            });
         }
-        return true;
+        return result;
     }
 
     // get word count
@@ -163,9 +756,23 @@ public:
         return wordCount == 0;
     }
 
-    // estimate memory usage
+    // true footprint: the trie object plus every slab the node pools and
+    // the key store hold
     size_t estimateMemory() const {
-        return memoryUsed;
+        return sizeof(*this) + path.capacity() * sizeof(TrieNode**) + pathKeys.capacity() +
+               keyBlocks.capacity() * sizeof(char*) + keyBytes + getReservedBytes();
+    }
+
+    // bytes reserved by the node pools
+    size_t getReservedBytes() const {
+        return pool4.bytesReserved() + pool16.bytesReserved() +
+               pool48.bytesReserved() + pool256.bytesReserved();
+    }
+
+    // bytes occupied by live nodes
+    size_t getUsedBytes() const {
+        return pool4.bytesUsed() + pool16.bytesUsed() +
+               pool48.bytesUsed() + pool256.bytesUsed();
     }
 };
 
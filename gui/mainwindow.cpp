@@ -303,6 +303,7 @@ void MainWindow::onLoadResultsClicked()
 
         currentResults.clear();
         currentScores.clear();
+        extendedResults.clear();
         
         int successCount = 0;
         int failCount = 0;
@@ -350,6 +351,17 @@ void MainWindow::onLoadResultsClicked()
             metrics.deleteTime = parseDouble(parts[4]);
             metrics.totalTime = parseDouble(parts[5]);
             metrics.memoryUsed = static_cast<size_t>(parseDouble(parts[6]));
+
+            // counts and traversal columns (files written with csvHeader);
+            // latency percentiles are summaries and are not re-imported
+            if (parts.size() >= 15) {
+                metrics.insertCount = parts[9].toInt();
+                metrics.searchCount = parts[10].toInt();
+                metrics.deleteCount = parts[11].toInt();
+                metrics.traversalTime = parseDouble(parts[12]);
+                metrics.traversalCount = parts[13].toLongLong();
+                metrics.edgesTraversed = parts[14].toLongLong();
+            }
             
             if (totalOk) {
                 // If we have a Score column (9th column), read it
@@ -731,6 +743,7 @@ void MainWindow::runAnalysis(AnalysisInputs inputs)
                                                    inputs.deletePercent, totalOps);
 
         currentResults = intBenchmark->runAllTests(data, opProfile);
+        extendedResults = intBenchmark->runExtendedTests(data, opProfile);
 
     } else if (inputs.dataType == "String") {
         std::vector<std::string> data;
@@ -774,6 +787,7 @@ void MainWindow::runAnalysis(AnalysisInputs inputs)
                                                            inputs.deletePercent, totalOps);
 
         currentResults = stringBenchmark->runAllTests(data, opProfile);
+        extendedResults = stringBenchmark->runExtendedTests(data, opProfile);
     }
 
     // Generate recommendations
@@ -901,14 +915,44 @@ void MainWindow::updateResultsPage(const std::map<std::string, PerformanceMetric
     performanceValue->setText(QString::number(winner.totalScore, 'f', 1) + "%");
 
     // Set warning based on structure
-    if (winner.name == "HashMap") {
+    if (winner.name == "HashMap" || winner.name == "FlatHashMap" ||
+        winner.name == "IncrementalHashMap") {
         warningText->setText("⚠️ Hash collisions may occur with large datasets");
     } else if (winner.name == "BST") {
         warningText->setText("⚠️ Performance degrades if tree becomes unbalanced");
     } else if (winner.name == "Heap") {
         warningText->setText("⚠️ Not suitable for searching arbitrary elements");
+    } else if (winner.name == "RadixHeap") {
+        warningText->setText("⚠️ Keys must never drop below the last extracted key");
+    } else if (winner.name == "Queue") {
+        warningText->setText("⚠️ Only the front and rear elements are accessible");
     } else if (winner.name == "Trie") {
         warningText->setText("⚠️ Memory intensive for long strings");
+    } else if (winner.name == "RadixTrie") {
+        warningText->setText("⚠️ Keeps a copy of inserted keys until cleared");
+    }
+
+    // Tail latency of the winner's interleaved operations
+    QLabel* latencyText = resultsPage->findChild<QLabel*>("latencyText");
+    if (latencyText) {
+        QStringList lines;
+        auto it = results.find(winner.name);
+        if (it != results.end()) {
+            auto addLine = [&](const QString& op, const LatencyHistogram& h) {
+                if (h.getCount() == 0) return;
+                // percentiles are recorded in nanoseconds, shown in microseconds
+                lines << QString("%1 p50 %2 µs · p99 %3 µs · p99.9 %4 µs")
+                             .arg(op)
+                             .arg(h.percentile(50) / 1000.0, 0, 'f', 2)
+                             .arg(h.percentile(99) / 1000.0, 0, 'f', 2)
+                             .arg(h.percentile(99.9) / 1000.0, 0, 'f', 2);
+            };
+            addLine("Search", it->second.searchLatency);
+            addLine("Insert", it->second.insertLatency);
+            addLine("Delete", it->second.deleteLatency);
+        }
+        latencyText->setText(lines.isEmpty() ? QString("Tail latency: not recorded")
+                                             : lines.join("\n"));
     }
 
     // Update analysis info
@@ -916,6 +960,22 @@ void MainWindow::updateResultsPage(const std::map<std::string, PerformanceMetric
     QLabel* sizeValue = resultsPage->findChild<QLabel*>("sizeValue");
     QLabel* operationsValue = resultsPage->findChild<QLabel*>("operationsValue");
 
+    // Variants and sweeps from runExtendedTests (shown, not ranked)
+    QLabel* extendedValue = resultsPage->findChild<QLabel*>("extendedValue");
+    if (extendedValue) {
+        QStringList lines;
+        for (const auto& pair : extendedResults) {
+            const PerformanceMetrics& m = pair.second;
+            QString name = QString::fromStdString(pair.first);
+            if (m.edgesTraversed > 0) {
+                lines << QString("%1: %2 MTEPS").arg(name).arg(m.getTEPS() / 1e6, 0, 'f', 1);
+            } else {
+                lines << QString("%1: %2 ms").arg(name).arg(m.totalTime, 0, 'f', 2);
+            }
+        }
+        extendedValue->setText(lines.isEmpty() ? QString("Not run") : lines.join("\n"));
+    }
+
     datasetValue->setText("Generated Test Data");
     sizeValue->setText(QString::number(profile.dataSize) + " elements");
 
@@ -988,8 +1048,7 @@ void MainWindow::onExportResultsClicked()
             // Export to CSV
             std::ofstream file(fileName.toStdString());
             if (file.is_open()) {
-                file << "Structure,DataSize,InsertTime(ms),SearchTime(ms),DeleteTime(ms),"
-                     << "TotalTime(ms),MemoryUsed(bytes),MemoryPerElement(bytes)\n";
+                file << PerformanceMetrics::csvHeader() << "\n";
 
                 for (const auto& pair : currentResults) {
                     file << pair.second.toCSV() << "\n";
@@ -1137,6 +1196,7 @@ void MainWindow::onSettingsClicked()
              recentDatasets.clear();
              currentResults.clear();
              currentScores.clear();
+             extendedResults.clear();
              updateDashboard();
              settingsDialog.accept();
          }
@@ -90,6 +90,7 @@ private:
 
     // Current analysis data
     std::map<std::string, PerformanceMetrics> currentResults;
+    std::map<std::string, PerformanceMetrics> extendedResults;  // unranked variants and sweeps
     DataAnalyzer::DataProfile currentProfile;
     std::vector<RecommendationEngine::StructureScore> currentScores;
     std::deque<std::string> recentDatasets;
@@ -0,0 +1,50 @@
+#include "Trie.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// remove-then-reinsert churn on a constant key set: in compressed mode the
+// key store must be reclaimed, so the footprint stays near its initial size
+int main() {
+    const int keyCount = 1000;
+    const int rounds = 200;
+
+    Trie trie(true);
+    vector<string> keys;
+    for (int i = 0; i < keyCount; i++) {
+        keys.push_back("user/session/" + to_string(i));
+        trie.insert(keys.back());
+    }
+
+    size_t initial = trie.estimateMemory();
+    size_t peak = initial;
+    for (int r = 0; r < rounds; r++) {
+        for (const string& key : keys)
+            trie.remove(key);
+        for (const string& key : keys)
+            trie.insert(key);
+        peak = max(peak, trie.estimateMemory());
+    }
+
+    for (const string& key : keys) {
+        if (!trie.search(key)) {
+            cerr << "FAIL: lost key " << key << endl;
+            return 1;
+        }
+    }
+    if (trie.size() != keyCount || trie.getAllWords().size() != keys.size()) {
+        cerr << "FAIL: word count " << trie.size() << endl;
+        return 1;
+    }
+
+    // dead key copies may at most double the live store between compactions
+    if (peak > 2 * initial) {
+        cerr << "FAIL: footprint grew from " << initial << " to " << peak << " bytes" << endl;
+        return 1;
+    }
+
+    cout << "Trie churn: " << initial << " bytes initially, " << peak << " bytes peak" << endl;
+    return 0;
+}